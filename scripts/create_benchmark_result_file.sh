@@ -5,6 +5,8 @@ set -euo pipefail
 if [ $# -ne 1 ]; then
     echo "Usage: $0 <TestName>"
     echo "Example: $0 MemoryPool"
+    echo "         $0 FixParser"
+    echo "Available: $(ls ./build/bin/*.bench 2>/dev/null | xargs -n1 basename 2>/dev/null | sed 's/\.bench$//' | tr '\n' ' ')"
     exit 1
 fi
 
@@ -1,8 +1,37 @@
-#include <string>
+#pragma once
+#include <concepts>
+#include <expected>
+#include <span>
+#include <string_view>
 
 class FixMessage;
+enum class FixError;    // defined in Errors.h
 
+/*
+Parses one complete FIX message into a message owned by the caller, so the same
+FixMessage can be reused for every inbound message. Malformed input is reported
+through the FixError code, never by throwing.
+*/
 class IFixParser {
 public:
-    virtual FixMessage parse(const std::string& rawFix) = 0;
+    virtual ~IFixParser() = default;
+
+    virtual std::expected<void, FixError> parse(std::string_view raw, FixMessage& msg) = 0;
+
+    // A template so strings, which convert to both, still pick the string_view overload
+    template<std::same_as<std::span<const char>> Span>
+    std::expected<void, FixError> parse(Span raw, FixMessage& msg) {
+        return parse(std::string_view(raw.data(), raw.size()), msg);
+    }
+};
+
+/*
+Statically dispatched counterpart of IFixParser for the hot path: code templated on a
+FixParserLike calls parseInto directly, with no virtual call. Malformed input comes
+back as a FixError; only running out of memory while the message grows (std::bad_alloc
+from its memory resource) is thrown.
+*/
+template<typename Parser>
+concept FixParserLike = requires(Parser& parser, std::string_view raw, FixMessage& msg) {
+    { parser.parseInto(raw, msg) } -> std::same_as<std::expected<void, FixError>>;
 };
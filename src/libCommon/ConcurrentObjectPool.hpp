@@ -0,0 +1,297 @@
+#pragma once
+#include "Macros.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*
+Object pool for objects allocated on one thread and freed on another, e.g. a message
+built on the network thread and released on the strategy thread.
+Every thread works on its own cache, so most calls touch no shared cache line:
+
+    allocate()    pops the thread's free list. When it is empty, takes everything other
+                  threads returned to this thread, then a batch from the depot, and only
+                  then carves a new slab.
+    deallocate()  pushes on the thread's free list when the object was allocated by this
+                  thread. Otherwise the object is kept in a pending batch for its owner and
+                  handed over batchSize objects at a time, with one CAS onto the owner's
+                  lock-free stack; flushRemoteFrees() hands over a partial batch.
+
+A thread holding more than two batches moves one to the global depot, which keeps at
+most depotBatches batches (beyond that they stay in the thread cache). The depot and
+slab growth are the only places taking a lock, once per batch.
+The cache of an exited thread, with whatever it holds, is adopted by the next thread
+that needs one. Objects still allocated when the pool goes away are destroyed with it.
+Freeing an object twice throws, unless both frees race on different threads.
+*/
+template<typename T>
+class ConcurrentObjectPool {
+    struct Cache;
+
+    struct Node {
+        Node* next;
+        Cache* owner;       // the cache it was allocated from, where it goes back to
+        bool live;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    // Singly linked list that knows its tail, so it can be pushed somewhere in one go
+    struct Chain {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        size_t count = 0;
+
+        void push(Node* node) {
+            node->next = head;
+            if (!head)
+                tail = node;
+            head = node;
+            ++count;
+        }
+        Node* pop() {
+            Node* node = head;
+            head = node->next;
+            if (--count == 0)
+                tail = nullptr;
+            return node;
+        }
+    };
+
+    struct Cache {
+        // Owning thread only
+        Chain local;
+        Cache* pendingOwner = nullptr;
+        Chain pending;                      // freed here, allocated from pendingOwner
+        bool orphaned = false;              // guarded by Shared::mutex
+
+        // Pushed to by other threads, taken as a whole by the owner
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> remoteFree = nullptr;
+    };
+
+    // Outlives the pool while an exiting thread is still handing its cache back
+    struct Shared {
+        const uint64_t id;
+        const size_t batchSize;
+        const size_t depotBatches;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Cache>> caches;
+        std::vector<Node*> slabs;
+        std::vector<Chain> depot;
+
+        Shared(uint64_t id, size_t batchSize, size_t depotBatches)
+            : id(id), batchSize(batchSize), depotBatches(depotBatches) {}
+
+        ~Shared() {
+            for (Node* slab : slabs) {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = 0; i < batchSize; ++i) {
+                        if (slab[i].live)
+                            std::destroy_at(object(&slab[i]));
+                    }
+                }
+                std::free(slab);
+            }
+        }
+    };
+
+    struct LocalCache {
+        uint64_t poolId;
+        Cache* cache;
+        std::weak_ptr<Shared> shared;
+    };
+
+    // This thread's caches, one per pool it used; handed back when the thread exits
+    struct LocalCaches {
+        uint64_t lastPoolId = 0;
+        Cache* last = nullptr;
+        std::vector<LocalCache> caches;
+
+        ~LocalCaches() {
+            for (auto& local : caches) {
+                if (auto shared = local.shared.lock())
+                    release(*shared, *local.cache);
+            }
+        }
+    };
+
+    static inline std::atomic<uint64_t> s_nextId = 1;
+    static inline thread_local LocalCaches t_caches;
+
+    std::shared_ptr<Shared> _shared;
+    uint64_t _id;
+
+public:
+    explicit ConcurrentObjectPool(size_t batchSize = 64, size_t depotBatches = 64)
+        : _shared(std::make_shared<Shared>(s_nextId.fetch_add(1, std::memory_order_relaxed),
+                                           std::max<size_t>(batchSize, 1), depotBatches))
+        , _id(_shared->id)
+    {}
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool(ConcurrentObjectPool&&) = delete;
+    ConcurrentObjectPool& operator=(ConcurrentObjectPool&&) = delete;
+
+    template<typename... Args>
+    T* allocate(Args&&... args) {
+        Cache& cache = localCache();
+        if (UNLIKELY(cache.local.count == 0))
+            refill(cache);
+        Node* node = cache.local.pop();
+        T* obj;
+        try {
+            obj = ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            cache.local.push(node);
+            throw;
+        }
+        node->owner = &cache;
+        node->live = true;
+        return obj;
+    }
+
+    // ptr must come from this pool, on any thread
+    void deallocate(T* ptr) {
+        Node* node = reinterpret_cast<Node*>(reinterpret_cast<std::byte*>(ptr) - offsetof(Node, storage));
+        if (UNLIKELY(!node->live))
+            throw std::runtime_error("Invalid pointer deallocation");
+        std::destroy_at(ptr);
+        node->live = false;
+
+        Cache& cache = localCache();
+        if (LIKELY(node->owner == &cache)) {
+            cache.local.push(node);
+            // Past two batches, and again every batch while the depot is full
+            size_t count = cache.local.count;
+            if (UNLIKELY(count > 2 * _shared->batchSize && count % _shared->batchSize == 1))
+                shed(cache);
+            return;
+        }
+        if (cache.pendingOwner != node->owner) {
+            flush(cache);
+            cache.pendingOwner = node->owner;
+        }
+        cache.pending.push(node);
+        if (UNLIKELY(cache.pending.count >= _shared->batchSize))
+            flush(cache);
+    }
+
+    // Hands objects this thread freed for other threads over now, e.g. before going idle
+    void flushRemoteFrees() { flush(localCache()); }
+
+    size_t slabCount() const {
+        std::lock_guard lock(_shared->mutex);
+        return _shared->slabs.size();
+    }
+    size_t depotBatchCount() const {
+        std::lock_guard lock(_shared->mutex);
+        return _shared->depot.size();
+    }
+    size_t threadCacheCount() const {
+        std::lock_guard lock(_shared->mutex);
+        return _shared->caches.size();
+    }
+
+private:
+    static T* object(Node* node) { return std::launder(reinterpret_cast<T*>(node->storage)); }
+
+    Cache& localCache() {
+        LocalCaches& local = t_caches;
+        if (LIKELY(local.lastPoolId == _id))
+            return *local.last;
+        return lookupCache(local);
+    }
+
+    Cache& lookupCache(LocalCaches& local) {
+        auto found = std::find_if(local.caches.begin(), local.caches.end(),
+            [&](const LocalCache& entry) { return entry.poolId == _id; });
+        if (found == local.caches.end()) {
+            // Forget pools that are gone before adding this one
+            std::erase_if(local.caches, [](const LocalCache& entry) { return entry.shared.expired(); });
+            local.caches.push_back(LocalCache{_id, &acquireCache(), _shared});
+            found = local.caches.end() - 1;
+        }
+        local.lastPoolId = _id;
+        local.last = found->cache;
+        return *found->cache;
+    }
+
+    // A cache left behind by an exited thread, or a new one
+    Cache& acquireCache() {
+        std::lock_guard lock(_shared->mutex);
+        for (auto& cache : _shared->caches) {
+            if (cache->orphaned) {
+                cache->orphaned = false;
+                return *cache;
+            }
+        }
+        return *_shared->caches.emplace_back(std::make_unique<Cache>());
+    }
+
+    static void release(Shared& shared, Cache& cache) {
+        flush(cache);
+        std::lock_guard lock(shared.mutex);
+        cache.orphaned = true;
+    }
+
+    // Pushes the pending batch onto its owner's stack in one CAS
+    static void flush(Cache& cache) {
+        if (cache.pending.count == 0)
+            return;
+        std::atomic<Node*>& stack = cache.pendingOwner->remoteFree;
+        Node* head = stack.load(std::memory_order_relaxed);
+        do {
+            cache.pending.tail->next = head;
+        } while (!stack.compare_exchange_weak(head, cache.pending.head,
+                                              std::memory_order_release, std::memory_order_relaxed));
+        cache.pending = Chain{};
+    }
+
+    void refill(Cache& cache) {
+        // Owner takes the whole stack at once, so there is no ABA to worry about
+        Node* returned = cache.remoteFree.exchange(nullptr, std::memory_order_acquire);
+        while (returned) {
+            Node* next = returned->next;
+            cache.local.push(returned);
+            returned = next;
+        }
+        if (cache.local.count != 0)
+            return;
+
+        std::lock_guard lock(_shared->mutex);
+        if (!_shared->depot.empty()) {
+            cache.local = _shared->depot.back();
+            _shared->depot.pop_back();
+            return;
+        }
+        size_t batchSize = _shared->batchSize;
+        size_t bytes = (batchSize * sizeof(Node) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+        auto* slab = static_cast<Node*>(std::aligned_alloc(std::max<size_t>(alignof(Node), CACHE_LINE_SIZE), bytes));
+        if (!slab)
+            throw std::bad_alloc();
+        _shared->slabs.push_back(slab);
+        for (size_t i = batchSize; i-- > 0;) {
+            slab[i].live = false;
+            cache.local.push(&slab[i]);
+        }
+    }
+
+    // Moves one batch from an overfull thread cache to the depot, if it has room
+    void shed(Cache& cache) {
+        std::lock_guard lock(_shared->mutex);
+        if (_shared->depot.size() >= _shared->depotBatches)
+            return;
+        Chain batch;
+        for (size_t i = 0; i < _shared->batchSize; ++i)
+            batch.push(cache.local.pop());
+        _shared->depot.push_back(batch);
+    }
+};
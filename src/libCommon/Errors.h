@@ -0,0 +1,41 @@
+#pragma once
+#include <string_view>
+
+// Error codes reported by the non-throwing FIX parsing and encoding paths.
+enum class FixError
+{
+    EmptyMessage,
+    MalformedField,     // token without '=' or without a terminating delimiter
+    InvalidTag,         // tag is empty, non-numeric or out of range
+    BufferTooSmall,     // encoder ran out of room in the caller's buffer
+    InvalidValue,       // value cannot be encoded as requested
+    InvalidBodyLength,  // BodyLength (9) missing, malformed or not ending at CheckSum (10)
+    ChecksumMismatch,   // CheckSum (10) differs from the bytes received
+    FrameTooLarge,      // message does not fit the framer's buffer
+    InvalidGroup        // repeating group count malformed or not matching its instances
+};
+
+constexpr std::string_view toString(FixError error)
+{
+    switch (error) {
+        case FixError::EmptyMessage:
+            return "FIX message is empty";
+        case FixError::MalformedField:
+            return "FIX field is malformed";
+        case FixError::InvalidTag:
+            return "FIX tag is invalid";
+        case FixError::BufferTooSmall:
+            return "FIX buffer is too small";
+        case FixError::InvalidValue:
+            return "FIX value is invalid";
+        case FixError::InvalidBodyLength:
+            return "FIX BodyLength is invalid";
+        case FixError::ChecksumMismatch:
+            return "FIX CheckSum does not match";
+        case FixError::FrameTooLarge:
+            return "FIX message is larger than the framer buffer";
+        case FixError::InvalidGroup:
+            return "FIX repeating group does not match its count";
+    }
+    return "Unknown FIX error";
+}
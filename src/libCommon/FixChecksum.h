@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Sum of all bytes, the FIX CheckSum (10) is this modulo 256 over everything before "10=".
+// Sums of adjacent ranges can be added, which lets split buffers be checked piecewise.
+inline uint32_t fixByteSum(std::string_view bytes)
+{
+    uint32_t sum = 0;
+    for (unsigned char c : bytes)
+        sum += c;
+    return sum;
+}
+
+inline uint8_t fixChecksum(std::string_view bytes)
+{
+    return static_cast<uint8_t>(fixByteSum(bytes) & 0xFF);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <string_view>
+
+/*
+Fixed point decimal: value = mantissa * 10^exponent.
+FIX prices and quantities are decimal strings, parsing them into a double loses
+precision (0.1 has no exact binary form), so they are kept as mantissa/exponent.
+"123.450" parses to {123450, -3}; trailing zeros are kept, comparisons are by value.
+*/
+struct FixDecimal {
+    int64_t mantissa = 0;
+    int8_t exponent = 0;
+
+    static constexpr int MAX_DIGITS = 18;   // always fits int64_t
+
+    // Parses [-]digits[.digits]. Returns false on anything else or more than MAX_DIGITS digits.
+    static constexpr bool parse(std::string_view text, FixDecimal& out)
+    {
+        size_t i = 0;
+        bool negative = false;
+        if (i < text.size() && text[i] == '-') {
+            negative = true;
+            ++i;
+        }
+
+        int64_t mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        bool seenPoint = false;
+        for (; i < text.size(); ++i) {
+            char c = text[i];
+            if (c == '.') {
+                if (seenPoint)
+                    return false;
+                seenPoint = true;
+                continue;
+            }
+            unsigned d = static_cast<unsigned>(c - '0');
+            if (d > 9 || ++digits > MAX_DIGITS)
+                return false;
+            mantissa = mantissa * 10 + d;
+            fractionDigits += seenPoint;
+        }
+        if (digits == 0)
+            return false;
+
+        out.mantissa = negative ? -mantissa : mantissa;
+        out.exponent = static_cast<int8_t>(-fractionDigits);
+        return true;
+    }
+
+    // Exact when |mantissa| < 2^53 and the exponent is within [-22, 22]
+    constexpr double toDouble() const
+    {
+        constexpr double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        double value = static_cast<double>(mantissa);
+        int e = exponent;
+        while (e < -22) { value /= 1e22; e += 22; }
+        while (e > 22) { value *= 1e22; e -= 22; }
+        return e < 0 ? value / powers[-e] : value * powers[e];
+    }
+
+    constexpr std::strong_ordering operator<=>(const FixDecimal& other) const
+    {
+        int sign = (mantissa > 0) - (mantissa < 0);
+        int otherSign = (other.mantissa > 0) - (other.mantissa < 0);
+        if (sign != otherSign || sign == 0)
+            return sign <=> otherSign;
+
+        // Same sign, both nonzero. Scaling by more than 19 digits takes the scaled side past
+        // any int64_t, so the larger exponent is the larger magnitude
+        constexpr int MAX_SCALE = 19;
+        int gap = exponent - other.exponent;
+        if (gap > MAX_SCALE || gap < -MAX_SCALE)
+            return (gap > 0) == (sign > 0) ? std::strong_ordering::greater : std::strong_ordering::less;
+
+        // Bring both to the smaller exponent, 2^63 * 10^19 still fits 128 bit
+        __extension__ typedef __int128 Wide;
+        Wide lhs = mantissa;
+        Wide rhs = other.mantissa;
+        for (int e = gap; e > 0; --e) lhs *= 10;
+        for (int e = gap; e < 0; ++e) rhs *= 10;
+        return lhs <=> rhs;
+    }
+
+    constexpr bool operator==(const FixDecimal& other) const
+    {
+        return (*this <=> other) == std::strong_ordering::equal;
+    }
+};
@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include "FixMessage.h"
+#include "FixDecimal.h"
+#include "FixValueDecoder.h"
+
+/*
+Compile time FIX dictionary.
+A field is a type carrying its tag, its C++ value type and the name of its accessor.
+A message is a TypedMessage over a list of fields: every field resolves to a fixed slot
+at compile time, so reading msg.price() is an array index plus the decode, with no
+hashing. Tags outside the dictionary stay reachable through message().
+*/
+
+template<size_t N>
+struct FixedString {
+    char value[N]{};
+
+    constexpr FixedString(const char (&str)[N]) { std::copy_n(str, N, value); }
+    constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+};
+
+// Defines field NAME and the accessor every message holding it gets.
+#define FIX_FIELD(NAME, TAG, TYPE, ACCESSOR)                                                   \
+    struct NAME {                                                                              \
+        static constexpr int tag = TAG;                                                        \
+        using type = TYPE;                                                                     \
+        template<typename Message>                                                             \
+        struct Accessor {                                                                      \
+            std::optional<TYPE> ACCESSOR() const {                                             \
+                return static_cast<const Message*>(this)->template get<NAME>();                \
+            }                                                                                  \
+        };                                                                                     \
+    }
+
+namespace FixDict
+{
+    struct FixVersion42 { static constexpr std::string_view beginString = "FIX.4.2"; };
+    struct FixVersion44 { static constexpr std::string_view beginString = "FIX.4.4"; };
+
+    // Standard header and trailer
+    FIX_FIELD(BeginString, 8, std::string_view, beginString);
+    FIX_FIELD(BodyLength, 9, uint32_t, bodyLength);
+    FIX_FIELD(CheckSum, 10, std::string_view, checkSum);
+    FIX_FIELD(MsgSeqNum, 34, uint64_t, msgSeqNum);
+    FIX_FIELD(MsgType, 35, std::string_view, msgType);
+    FIX_FIELD(SenderCompID, 49, std::string_view, senderCompId);
+    FIX_FIELD(SendingTime, 52, std::string_view, sendingTime);
+    FIX_FIELD(TargetCompID, 56, std::string_view, targetCompId);
+
+    // Orders and executions
+    FIX_FIELD(Account, 1, std::string_view, account);
+    FIX_FIELD(AvgPx, 6, FixDecimal, avgPx);
+    FIX_FIELD(ClOrdID, 11, std::string_view, clOrdId);
+    FIX_FIELD(CumQty, 14, FixDecimal, cumQty);
+    FIX_FIELD(ExecID, 17, std::string_view, execId);
+    FIX_FIELD(ExecTransType, 20, char, execTransType);
+    FIX_FIELD(HandlInst, 21, char, handlInst);
+    FIX_FIELD(LastPx, 31, FixDecimal, lastPx);
+    FIX_FIELD(LastQty, 32, FixDecimal, lastQty);
+    FIX_FIELD(OrderID, 37, std::string_view, orderId);
+    FIX_FIELD(OrderQty, 38, FixDecimal, orderQty);
+    FIX_FIELD(OrdStatus, 39, char, ordStatus);
+    FIX_FIELD(OrdType, 40, char, ordType);
+    FIX_FIELD(OrigClOrdID, 41, std::string_view, origClOrdId);
+    FIX_FIELD(Price, 44, FixDecimal, price);
+    FIX_FIELD(Side, 54, char, side);
+    FIX_FIELD(Symbol, 55, std::string_view, symbol);
+    FIX_FIELD(Text, 58, std::string_view, text);
+    FIX_FIELD(TimeInForce, 59, char, timeInForce);
+    FIX_FIELD(TransactTime, 60, std::string_view, transactTime);
+    FIX_FIELD(ExecType, 150, char, execType);
+    FIX_FIELD(LeavesQty, 151, FixDecimal, leavesQty);
+
+    // Market data
+    FIX_FIELD(MDReqID, 262, std::string_view, mdReqId);
+    FIX_FIELD(NoMDEntries, 268, uint32_t, noMdEntries);
+    FIX_FIELD(MDEntryType, 269, char, mdEntryType);
+    FIX_FIELD(MDEntryPx, 270, FixDecimal, mdEntryPx);
+    FIX_FIELD(MDEntrySize, 271, FixDecimal, mdEntrySize);
+    FIX_FIELD(MDUpdateAction, 279, char, mdUpdateAction);
+
+    template<typename Field, typename... Fields>
+    constexpr size_t slotOf()
+    {
+        constexpr std::array<bool, sizeof...(Fields)> matches = {std::is_same_v<Field, Fields>...};
+        return static_cast<size_t>(std::find(matches.begin(), matches.end(), true) - matches.begin());
+    }
+
+    template<typename... Fields>
+    constexpr bool uniqueTags()
+    {
+        std::array<int, sizeof...(Fields)> tags = {Fields::tag...};
+        std::sort(tags.begin(), tags.end());
+        return std::adjacent_find(tags.begin(), tags.end()) == tags.end();
+    }
+}
+
+/*
+Typed view of a FixMessage for one message type of one FIX version.
+bind() walks the message once and records where every dictionary field sits;
+the accessors then index straight into those slots. The FixMessage must outlive
+the typed view and stay unmodified while bound.
+*/
+template<typename Version, FixedString Type, typename... Fields>
+class TypedMessage : public Fields::template Accessor<TypedMessage<Version, Type, Fields...>>... {
+    static_assert(FixDict::uniqueTags<Fields...>(), "TypedMessage: every tag may appear once");
+
+    static constexpr int MAX_TAG = std::max({Fields::tag...});
+
+    // tag -> slot, -1 for tags outside this message's dictionary
+    static constexpr std::array<int16_t, MAX_TAG + 1> SLOT_OF_TAG = [] {
+        std::array<int16_t, MAX_TAG + 1> table{};
+        table.fill(-1);
+        int16_t slot = 0;
+        ((table[Fields::tag] = slot++), ...);
+        return table;
+    }();
+
+    const FixMessage* _msg = nullptr;
+    std::array<uint32_t, sizeof...(Fields)> _slots{};   // field index + 1, 0 when absent
+
+public:
+    static constexpr std::string_view beginString = Version::beginString;
+    static constexpr std::string_view msgType = Type.view();
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    template<typename Field>
+    static constexpr size_t slotOf() { return FixDict::slotOf<Field, Fields...>(); }
+
+    TypedMessage() = default;
+    explicit TypedMessage(const FixMessage& msg) { bind(msg); }
+
+    // Returns false when the message's MsgType (35) is not this type; fields are bound either way.
+    bool bind(const FixMessage& msg) {
+        _msg = &msg;
+        _slots.fill(0);
+        for (size_t i = 0; i < msg.fieldCount(); ++i) {
+            int tag = msg.field(i).tag;
+            if (tag < 0 || tag > MAX_TAG)
+                continue;
+            int16_t slot = SLOT_OF_TAG[tag];
+            // First occurrence wins, as for FixMessage lookups
+            if (slot >= 0 && _slots[slot] == 0)
+                _slots[slot] = static_cast<uint32_t>(i + 1);
+        }
+        return msg.getFieldView(FixDict::MsgType::tag) == msgType;
+    }
+
+    template<typename Field>
+    bool has() const {
+        static_assert(slotOf<Field>() < FIELD_COUNT, "TypedMessage: field is not part of this message");
+        return _slots[slotOf<Field>()] != 0;
+    }
+
+    template<typename Field>
+    std::optional<typename Field::type> get() const {
+        static_assert(slotOf<Field>() < FIELD_COUNT, "TypedMessage: field is not part of this message");
+        uint32_t index = _slots[slotOf<Field>()];
+        if (index == 0)
+            return std::nullopt;
+
+        typename Field::type val{};
+        if (!decodeFixValue(_msg->field(index - 1).value, val))
+            return std::nullopt;
+        return val;
+    }
+
+    // Generic access, also for tags outside the dictionary
+    const FixMessage& message() const { return *_msg; }
+};
+
+// Every message carries the standard header and trailer
+template<typename Version, FixedString Type, typename... Body>
+using FixMessageDef = TypedMessage<Version, Type,
+    FixDict::BeginString, FixDict::BodyLength, FixDict::MsgType, FixDict::SenderCompID,
+    FixDict::TargetCompID, FixDict::MsgSeqNum, FixDict::SendingTime,
+    Body...,
+    FixDict::CheckSum>;
+
+namespace Fix42
+{
+    using namespace FixDict;
+
+    using NewOrderSingle = FixMessageDef<FixVersion42, "D",
+        ClOrdID, Account, HandlInst, Symbol, Side, TransactTime, OrderQty, OrdType, Price, TimeInForce, Text>;
+
+    using ExecutionReport = FixMessageDef<FixVersion42, "8",
+        OrderID, ClOrdID, ExecID, ExecTransType, ExecType, OrdStatus, Symbol, Side, OrderQty, Price,
+        LastPx, LastQty, LeavesQty, CumQty, AvgPx, Text>;
+
+    using OrderCancelRequest = FixMessageDef<FixVersion42, "F",
+        OrigClOrdID, ClOrdID, Symbol, Side, TransactTime, OrderQty>;
+
+    using MarketDataSnapshotFullRefresh = FixMessageDef<FixVersion42, "W",
+        MDReqID, Symbol, NoMDEntries>;
+
+    using MarketDataIncrementalRefresh = FixMessageDef<FixVersion42, "X",
+        MDReqID, NoMDEntries>;
+}
+
+namespace Fix44
+{
+    using namespace FixDict;
+
+    // HandlInst is optional in 4.4 but still sent by most venues
+    using NewOrderSingle = FixMessageDef<FixVersion44, "D",
+        ClOrdID, Account, HandlInst, Symbol, Side, TransactTime, OrderQty, OrdType, Price, TimeInForce, Text>;
+
+    // ExecTransType was removed in 4.4
+    using ExecutionReport = FixMessageDef<FixVersion44, "8",
+        OrderID, ClOrdID, ExecID, ExecType, OrdStatus, Symbol, Side, OrderQty, Price,
+        LastPx, LastQty, LeavesQty, CumQty, AvgPx, Text>;
+
+    using OrderCancelRequest = FixMessageDef<FixVersion44, "F",
+        OrigClOrdID, ClOrdID, Symbol, Side, TransactTime, OrderQty>;
+
+    using MarketDataSnapshotFullRefresh = FixMessageDef<FixVersion44, "W",
+        MDReqID, Symbol, NoMDEntries>;
+
+    using MarketDataIncrementalRefresh = FixMessageDef<FixVersion44, "X",
+        MDReqID, NoMDEntries>;
+}
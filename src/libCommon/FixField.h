@@ -0,0 +1,8 @@
+#pragma once
+#include <string_view>
+
+// One tag=value pair. value is never owned by the field.
+struct FixField {
+    int tag;
+    std::string_view value;
+};
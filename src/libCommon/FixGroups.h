@@ -0,0 +1,52 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <span>
+
+/*
+Repeating groups the parser indexes instead of flattening.
+A group starts with its NoXxx count field. The first tag after the count delimits the
+instances (it differs between messages: 269 in a snapshot, 279 in an incremental
+refresh, for NoMDEntries), and the group ends at the first tag that is not a member.
+Tags of nested groups are listed as members of their parent, so a nested group stays
+inside the instance holding it.
+*/
+struct FixGroupDef {
+    int countTag;
+    std::span<const int> memberTags;   // sorted
+
+    bool isMember(int tag) const { return std::binary_search(memberTags.begin(), memberTags.end(), tag); }
+};
+
+namespace FixGroups
+{
+    inline constexpr std::array MD_ENTRY_TAGS = {
+        15, 18, 22, 37, 48, 55, 58, 59, 65, 83, 107, 110, 126, 167, 200, 207, 231, 269, 270, 271, 272, 273,
+        274, 275, 276, 277, 278, 279, 280, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 299, 336,
+        346, 354, 355, 432, 451, 454, 455, 456, 461, 541, 546, 625, 811, 1023, 1070};
+
+    inline constexpr std::array PARTY_TAGS = {447, 448, 452, 523, 802, 803};
+
+    inline constexpr std::array LEG_TAGS = {
+        524, 525, 538, 539, 545, 556, 564, 565, 566, 587, 588, 600, 601, 602, 603, 604, 605, 606, 607, 608,
+        609, 610, 611, 612, 613, 614, 615, 616, 617, 618, 619, 620, 621, 622, 623, 624, 654, 675, 683,
+        685, 687, 688, 689, 690, 739, 740, 804, 805, 955, 956, 990, 1152};
+
+    static_assert(std::ranges::is_sorted(MD_ENTRY_TAGS) && std::ranges::is_sorted(PARTY_TAGS)
+                  && std::ranges::is_sorted(LEG_TAGS), "FixGroups: member tags must be sorted");
+
+    inline constexpr FixGroupDef NoMDEntries{268, MD_ENTRY_TAGS};
+    inline constexpr FixGroupDef NoPartyIDs{453, PARTY_TAGS};
+    inline constexpr FixGroupDef NoLegs{555, LEG_TAGS};
+
+    // Group started by countTag, nullptr when the tag is not a known group count
+    constexpr const FixGroupDef* find(int countTag)
+    {
+        switch (countTag) {
+            case 268: return &NoMDEntries;
+            case 453: return &NoPartyIDs;
+            case 555: return &NoLegs;
+            default: return nullptr;
+        }
+    }
+}
@@ -1,28 +1,78 @@
 #include "FixMessage.h"
 #include "FixExceptions.h"
+#include "Macros.h"
+#include <limits>
 
-void FixMessage::addField(int tag, const std::string& value) {
-        _fields[tag] = value;
+void FixMessage::addField(int tag, std::string_view value) {
+    FieldEntry e{tag, static_cast<uint32_t>(_values.size()), static_cast<uint32_t>(value.size())};
+    _values.append(value);
+
+    if (LIKELY(_fieldCount < FIX_MESSAGE_INLINE_FIELDS))
+        _inlineEntries[_fieldCount] = e;
+    else
+        _overflowEntries.push_back(e);
+
+    // Only the first occurrence of a tag is indexed
+    if (tag >= 0 && tag < FIX_DENSE_TAG_LIMIT && _denseIndex[tag] == 0
+        && _fieldCount < std::numeric_limits<uint16_t>::max()) {
+        _denseIndex[tag] = static_cast<uint16_t>(_fieldCount + 1);
     }
+    ++_fieldCount;
+}
+
+void FixMessage::clear() {
+    // Reset only the index slots in use instead of the whole table
+    for (size_t i = 0; i < _fieldCount; ++i) {
+        int tag = entry(i).tag;
+        if (tag >= 0 && tag < FIX_DENSE_TAG_LIMIT)
+            _denseIndex[tag] = 0;
+    }
+    _overflowEntries.clear();
+    _values.clear();
+    _fieldCount = 0;
+}
+
+const FixMessage::FieldEntry* FixMessage::findEntry(int tag) const {
+    if (tag >= 0 && tag < FIX_DENSE_TAG_LIMIT) {
+        uint16_t slot = _denseIndex[tag];
+        if (slot != 0)
+            return &entry(slot - 1);
+        if (LIKELY(_fieldCount < std::numeric_limits<uint16_t>::max()))
+            return nullptr;
+    }
+    for (size_t i = 0; i < _fieldCount; ++i) {
+        if (entry(i).tag == tag)
+            return &entry(i);
+    }
+    return nullptr;
+}
+
+std::optional<std::string_view> FixMessage::getFieldView(int tag) const {
+    const FieldEntry* e = findEntry(tag);
+    if (e == nullptr)
+        return std::nullopt;
+    return std::string_view(_values).substr(e->offset, e->length);
+}
 
 std::string FixMessage::getFieldStr(int tag) const {
-    auto it = _fields.find(tag);
-    if (it != _fields.end()) 
-        return it->second;
+    auto value = getFieldView(tag);
+    if (value) 
+        return std::string(*value);
     throw FixFieldNotFoundException(tag);
 }
 
 bool FixMessage::tryGetFieldStr(int tag, std::string& val) const {
-    auto it = _fields.find(tag);
-    if (it == _fields.end()) 
+    auto value = getFieldView(tag);
+    if (!value) 
         return false;
-    val = it->second;
+    val = *value;
     return true;
 }
 
 void FixMessage::print() const {
-    for (const auto& kv : _fields) {
-        std::cout << kv.first << "=" << kv.second << " ";
+    for (size_t i = 0; i < _fieldCount; ++i) {
+        FixField f = field(i);
+        std::cout << f.tag << "=" << f.value << " ";
     }
     std::cout << std::endl;
-}
\ No newline at end of file
+}
@@ -1,40 +1,78 @@
 #pragma once
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <optional>
 #include <iostream>
+#include "FixField.h"
+#include "FixValueDecoder.h"
 
+static const size_t FIX_MESSAGE_INLINE_FIELDS = 64;
+static const int FIX_DENSE_TAG_LIMIT = 1024;   // tags below this are found through a direct index
+
+/*
+Owning FIX message with flat storage.
+Values live back to back in one byte buffer and every field is a (tag, offset, length)
+entry kept in wire order, the first FIX_MESSAGE_INLINE_FIELDS of them inline in the
+object. Repeated tags (repeating groups) are all kept; lookups by tag return the first
+occurrence. clear() keeps every buffer so a message reused per inbound message stops
+allocating once it has warmed up.
+The value buffer and the overflow entries come from the memory resource given at
+construction, e.g. a MessageArena owned by the session (MemoryResource.hpp).
+*/
 class FixMessage {
-    std::unordered_map<int, std::string> _fields;
+    struct FieldEntry {
+        int tag;
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    std::array<FieldEntry, FIX_MESSAGE_INLINE_FIELDS> _inlineEntries;
+    std::pmr::vector<FieldEntry> _overflowEntries;
+    size_t _fieldCount = 0;
+    std::pmr::string _values;
+    // tag -> entry index + 1 of its first occurrence, 0 when the tag is absent
+    std::array<uint16_t, FIX_DENSE_TAG_LIMIT> _denseIndex{};
+
+    const FieldEntry& entry(size_t index) const {
+        return index < FIX_MESSAGE_INLINE_FIELDS ? _inlineEntries[index] : _overflowEntries[index - FIX_MESSAGE_INLINE_FIELDS];
+    }
+    const FieldEntry* findEntry(int tag) const;
+
 public:
+    explicit FixMessage(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : _overflowEntries(resource), _values(resource) {}
+
+    std::pmr::memory_resource* resource() const { return _values.get_allocator().resource(); }
+
+    void addField(int tag, std::string_view value);
+    void clear();
 
-    void addField(int tag, const std::string& value);
-    
     std::string getFieldStr(int tag) const;
     bool tryGetFieldStr(int tag, std::string& val) const;
+    std::optional<std::string_view> getFieldView(int tag) const;
 
+    // Fields in wire order
+    size_t fieldCount() const { return _fieldCount; }
+    FixField field(size_t index) const {
+        const FieldEntry& e = entry(index);
+        return FixField{e.tag, std::string_view(_values).substr(e.offset, e.length)};
+    }
+
+    // Typed read, see FixValueDecoder.h for the supported types.
+    // Prices and quantities should be read as FixDecimal, std::string returns the whole value.
     template<typename T>
     std::optional<T> getField(int tag) const {
-        auto it = _fields.find(tag);
-        if (it == _fields.end()) return std::nullopt;
+        auto value = getFieldView(tag);
+        if (!value) return std::nullopt;
 
-        std::istringstream iss(it->second);
-        T val;
-        if (!(iss >> val)) return std::nullopt;
+        T val{};
+        if (!decodeFixValue(*value, val)) return std::nullopt;
         return val;
     }
 
-    /*
-    We need specilization for std::string because, 
-    std::istringstream >> std::string only reads upto the first whitespace.
-    */
-    // template<>
-    // std::optional<std::string> getField<std::string>(int tag) const {
-    //     auto it = _fields.find(tag);
-    //     if (it == _fields.end()) return std::nullopt;
-    //     return it->second;
-    // }
-
     void print() const;
 };
@@ -0,0 +1,98 @@
+#include "FixMessageView.h"
+#include "FixMessage.h"
+#include <algorithm>
+
+std::optional<std::string_view> FixMessageView::getFieldView(int tag) const {
+    for (const auto& field : _fields) {
+        if (field.tag == tag)
+            return field.value;
+    }
+    return std::nullopt;
+}
+
+bool FixMessageView::tryGetFieldStr(int tag, std::string_view& val) const {
+    auto value = getFieldView(tag);
+    if (!value)
+        return false;
+    val = *value;
+    return true;
+}
+
+void FixMessageView::beginGroup(char delimiter) {
+    _delimiter = delimiter;
+    _groups.push_back(GroupEntry{_fields.back().tag, static_cast<uint32_t>(_fields.size() - 1),
+                                 static_cast<uint32_t>(_instances.size()), 0});
+}
+
+void FixMessageView::addGroupInstance(const char* start) {
+    GroupEntry& group = _groups.back();
+    if (group.instanceCount > 0) {
+        std::string_view& previous = _instances.back();
+        previous = std::string_view(previous.data(), start - previous.data());
+    }
+    _instances.emplace_back(start, 0);
+    ++group.instanceCount;
+}
+
+void FixMessageView::endGroup(const char* end) {
+    if (_groups.back().instanceCount > 0) {
+        std::string_view& last = _instances.back();
+        last = std::string_view(last.data(), end - last.data());
+    }
+}
+
+FixGroupView FixMessageView::group(int countTag) const {
+    for (const auto& group : _groups) {
+        if (group.countTag == countTag)
+            return FixGroupView(_instances.data() + group.firstInstance, group.instanceCount, _delimiter);
+    }
+    return FixGroupView();
+}
+
+FixMessage FixMessageView::toFixMessage(std::pmr::memory_resource* resource) const {
+    FixMessage msg(resource);
+    auto group = _groups.begin();
+    for (size_t i = 0; i < _fields.size(); ++i) {
+        msg.addField(_fields[i].tag, _fields[i].value);
+
+        // Instances go right after their count field, as on the wire
+        if (group != _groups.end() && group->countField == i) {
+            FixGroupView instances(_instances.data() + group->firstInstance, group->instanceCount, _delimiter);
+            for (FixGroupInstance instance : instances) {
+                for (const FixField& field : instance)
+                    msg.addField(field.tag, field.value);
+            }
+            ++group;
+        }
+    }
+    return msg;
+}
+
+void FixGroupInstance::Iterator::decode() {
+    if (_pos == _end)
+        return;
+
+    std::string_view rest(_pos, _end - _pos);
+    size_t fieldEnd = rest.find(_delimiter);
+    if (fieldEnd == std::string_view::npos)
+        fieldEnd = rest.size();
+    _next = _pos + std::min(fieldEnd + 1, rest.size());
+
+    std::string_view field = rest.substr(0, fieldEnd);
+    size_t equals = field.find('=');
+    if (equals == std::string_view::npos)
+        equals = field.size();
+
+    _field.tag = 0;
+    if (!decodeFixInteger(field.substr(0, equals), _field.tag))
+        _field.tag = 0;
+    _field.value = field.substr(std::min(equals + 1, field.size()));
+}
+
+std::optional<std::string_view> FixGroupInstance::getFieldView(int tag) const {
+    for (const FixField& field : *this) {
+        if (field.tag == tag)
+            return field.value;
+    }
+    return std::nullopt;
+}
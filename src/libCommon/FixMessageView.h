@@ -0,0 +1,154 @@
+#pragma once
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include "FixField.h"
+#include "FixValueDecoder.h"
+
+class FixMessage;
+
+/*
+Fields of one repeating group instance, still in their wire form.
+Nothing is decoded until the instance is iterated or looked up.
+*/
+class FixGroupInstance {
+    std::string_view _raw;      // "tag=value<delimiter>..." of this instance only
+    char _delimiter;
+
+public:
+    // Decodes one field per step; a field whose tag is not a number comes out as tag 0
+    class Iterator {
+        const char* _pos;           // first byte of the current field
+        const char* _end;
+        const char* _next = nullptr;
+        char _delimiter;
+        FixField _field{};
+
+        void decode();
+    public:
+        Iterator(const char* pos, const char* end, char delimiter) : _pos(pos), _end(end), _delimiter(delimiter) { decode(); }
+
+        const FixField& operator*() const { return _field; }
+        const FixField* operator->() const { return &_field; }
+        Iterator& operator++() { _pos = _next; decode(); return *this; }
+        bool operator==(const Iterator& other) const { return _pos == other._pos; }
+    };
+
+    FixGroupInstance(std::string_view raw, char delimiter) : _raw(raw), _delimiter(delimiter) {}
+
+    Iterator begin() const { return Iterator(_raw.data(), _raw.data() + _raw.size(), _delimiter); }
+    Iterator end() const { return Iterator(_raw.data() + _raw.size(), _raw.data() + _raw.size(), _delimiter); }
+
+    std::optional<std::string_view> getFieldView(int tag) const;
+
+    template<typename T>
+    std::optional<T> getField(int tag) const {
+        auto value = getFieldView(tag);
+        if (!value) return std::nullopt;
+
+        T val{};
+        if (!decodeFixValue(*value, val)) return std::nullopt;
+        return val;
+    }
+
+    std::string_view raw() const { return _raw; }
+};
+
+/*
+Instances of one repeating group, located by the parser in its single pass over the
+message. Indexing an instance is O(1); its fields are only decoded when used.
+*/
+class FixGroupView {
+    const std::string_view* _instances = nullptr;
+    size_t _size = 0;
+    char _delimiter = '\x01';
+
+public:
+    FixGroupView() = default;
+    FixGroupView(const std::string_view* instances, size_t size, char delimiter)
+        : _instances(instances), _size(size), _delimiter(delimiter) {}
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    FixGroupInstance operator[](size_t index) const { return FixGroupInstance(_instances[index], _delimiter); }
+
+    class Iterator {
+        const FixGroupView* _group;
+        size_t _index;
+    public:
+        Iterator(const FixGroupView* group, size_t index) : _group(group), _index(index) {}
+        FixGroupInstance operator*() const { return (*_group)[_index]; }
+        Iterator& operator++() { ++_index; return *this; }
+        bool operator==(const Iterator& other) const { return _index == other._index; }
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, _size); }
+};
+
+/*
+Non-owning view of a parsed FIX message.
+Values point straight into the caller's receive buffer, so the view is only
+valid as long as that buffer is. The field index is kept across clear() so a
+view reused for every inbound message stops allocating once it has warmed up.
+Use toFixMessage() when a message has to outlive the buffer.
+The field and group indexes come from the memory resource given at construction.
+
+Repeating groups known to FixGroups.h are not flattened: the fields of their
+instances are left out of the field list and are reached through group(countTag),
+which hands out the instances located while parsing.
+*/
+class FixMessageView {
+    struct GroupEntry {
+        int countTag;
+        uint32_t countField;        // index in _fields of the NoXxx field
+        uint32_t firstInstance;     // index in _instances
+        uint32_t instanceCount;
+    };
+
+    std::pmr::vector<FixField> _fields;
+    std::pmr::vector<GroupEntry> _groups;
+    std::pmr::vector<std::string_view> _instances;
+    char _delimiter = '\x01';
+
+public:
+    explicit FixMessageView(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : _fields(resource), _groups(resource), _instances(resource) {}
+
+    void clear() { _fields.clear(); _groups.clear(); _instances.clear(); }
+    void addField(int tag, std::string_view value) { _fields.push_back(FixField{tag, value}); }
+
+    // Called by the parser: the field just added is the count of a group, then each instance's
+    // first byte, then the end of the group.
+    void beginGroup(char delimiter);
+    void addGroupInstance(const char* start);
+    void endGroup(const char* end);
+
+    // First group started by countTag, empty when the message has none
+    FixGroupView group(int countTag) const;
+
+    std::optional<std::string_view> getFieldView(int tag) const;
+    bool tryGetFieldStr(int tag, std::string_view& val) const;
+
+    template<typename T>
+    std::optional<T> getField(int tag) const {
+        auto value = getFieldView(tag);
+        if (!value) return std::nullopt;
+
+        T val{};
+        if (!decodeFixValue(*value, val)) return std::nullopt;
+        return val;
+    }
+
+    size_t size() const { return _fields.size(); }
+    bool empty() const { return _fields.empty(); }
+    const FixField& operator[](size_t index) const { return _fields[index]; }
+    auto begin() const { return _fields.begin(); }
+    auto end() const { return _fields.end(); }
+
+    // Copies every field, group instances included, into an owning FixMessage
+    // allocating from resource.
+    FixMessage toFixMessage(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+};
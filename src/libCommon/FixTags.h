@@ -0,0 +1,36 @@
+#pragma once
+#include <array>
+
+// Tag numbers used by name across the engine.
+namespace FixTag
+{
+    inline constexpr int BeginString = 8;
+    inline constexpr int BodyLength = 9;
+    inline constexpr int CheckSum = 10;
+    inline constexpr int ClOrdID = 11;
+    inline constexpr int CumQty = 14;
+    inline constexpr int LastPx = 31;
+    inline constexpr int LastQty = 32;
+    inline constexpr int MsgSeqNum = 34;
+    inline constexpr int MsgType = 35;
+    inline constexpr int OrderQty = 38;
+    inline constexpr int Price = 44;
+    inline constexpr int SenderCompID = 49;
+    inline constexpr int SendingTime = 52;
+    inline constexpr int Side = 54;
+    inline constexpr int Symbol = 55;
+    inline constexpr int TargetCompID = 56;
+    inline constexpr int LeavesQty = 151;
+
+    // Price and quantity tags, decoded as FixDecimal so they never pass through double
+    inline constexpr std::array<int, 6> DecimalTags = {Price, OrderQty, LastPx, LastQty, CumQty, LeavesQty};
+
+    constexpr bool isDecimalTag(int tag)
+    {
+        for (int t : DecimalTags) {
+            if (t == tag)
+                return true;
+        }
+        return false;
+    }
+}
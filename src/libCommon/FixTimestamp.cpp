@@ -0,0 +1,40 @@
+#include "FixTimestamp.h"
+
+namespace {
+    void put2(char* out, unsigned value)
+    {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+}
+
+void FixTimestampFormatter::formatPrefix(int64_t second)
+{
+    _cachedSecond = second;
+
+    // Days since 1970-01-01 to year/month/day, proleptic Gregorian (H. Hinnant's civil_from_days)
+    int64_t days = second >= 0 ? second / 86400 : (second - 86399) / 86400;
+    int64_t secondOfDay = second - days * 86400;
+
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned dayOfEra = static_cast<unsigned>(z - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned mp = (5 * dayOfYear + 2) / 153;
+    unsigned day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    unsigned year = static_cast<unsigned>(yearOfEra + era * 400 + (month <= 2));
+
+    put2(_text, year / 100);
+    put2(_text + 2, year % 100);
+    put2(_text + 4, month);
+    put2(_text + 6, day);
+    _text[8] = '-';
+    put2(_text + 9, static_cast<unsigned>(secondOfDay / 3600));
+    _text[11] = ':';
+    put2(_text + 12, static_cast<unsigned>(secondOfDay / 60 % 60));
+    _text[14] = ':';
+    put2(_text + 15, static_cast<unsigned>(secondOfDay % 60));
+    _text[17] = '.';
+}
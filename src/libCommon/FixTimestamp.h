@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+#include "Macros.h"
+
+// "YYYYMMDD-HH:MM:SS.sssssssss"
+static const size_t FIX_TIMESTAMP_MAX_LENGTH = 27;
+
+// Digits after the seconds in a FIX UTCTimestamp
+enum class FixTimePrecision
+{
+    Seconds = 0,
+    Millis = 3,
+    Micros = 6,
+    Nanos = 9
+};
+
+namespace FixClock
+{
+    // Wall clock in nanoseconds since the Unix epoch. CLOCK_REALTIME is served by the
+    // vDSO on Linux, no system call on the hot path.
+    inline uint64_t nowNs()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+}
+
+/*
+Formats FIX UTCTimestamp values (tag 52, 60, ...) into its own buffer.
+The "YYYYMMDD-HH:MM:SS" prefix only changes once a second, so it is kept and only the
+sub-second digits are rewritten, no calendar math and no std::format per message.
+Not thread safe: one formatter per thread or per session. The returned view stays
+valid until the next call.
+
+    FixTimestampFormatter clock(FixTimePrecision::Micros);
+    std::string_view sendingTime = clock.format(FixClock::nowNs());
+*/
+class FixTimestampFormatter {
+    char _text[FIX_TIMESTAMP_MAX_LENGTH];
+    int64_t _cachedSecond = -1;
+    FixTimePrecision _precision;
+
+    void formatPrefix(int64_t second);
+
+public:
+    explicit FixTimestampFormatter(FixTimePrecision precision = FixTimePrecision::Millis) : _precision(precision) {}
+
+    std::string_view format(uint64_t epochNs);
+    std::string_view now() { return format(FixClock::nowNs()); }
+
+    FixTimePrecision precision() const { return _precision; }
+    // Length of every timestamp this formatter writes
+    size_t length() const { return 17 + (_precision == FixTimePrecision::Seconds ? 0 : 1 + static_cast<size_t>(_precision)); }
+};
+
+inline std::string_view FixTimestampFormatter::format(uint64_t epochNs)
+{
+    int64_t second = static_cast<int64_t>(epochNs / 1'000'000'000ull);
+    if (UNLIKELY(second != _cachedSecond))
+        formatPrefix(second);
+
+    // Fraction digits right to left, truncated (not rounded) to the precision
+    static constexpr uint32_t SCALE[10] = {1'000'000'000, 0, 0, 1'000'000, 0, 0, 1'000, 0, 0, 1};
+    int digits = static_cast<int>(_precision);
+    uint32_t fraction = static_cast<uint32_t>(epochNs % 1'000'000'000ull) / SCALE[digits];
+    for (int i = digits; i > 0; --i) {
+        _text[17 + i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return std::string_view(_text, length());
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <charconv>
+#include <concepts>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "FixDecimal.h"
+
+/*
+Decoding of FIX field values into C++ types without allocation or locale lookups.
+Integers are parsed by hand, floating point through std::from_chars, prices and
+quantities through FixDecimal. Types without a dedicated decoder fall back to
+std::istringstream.
+*/
+
+template<std::integral T>
+constexpr bool decodeFixInteger(std::string_view text, T& out)
+{
+    using U = std::make_unsigned_t<T>;
+    size_t i = 0;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (!text.empty() && text[0] == '-') {
+            negative = true;
+            i = 1;
+        }
+    }
+    if (i == text.size())
+        return false;
+
+    // Accumulate as unsigned, the limit allows one more for the most negative value
+    const U limit = negative ? static_cast<U>(std::numeric_limits<T>::max()) + 1 : static_cast<U>(std::numeric_limits<T>::max());
+    U value = 0;
+    for (; i < text.size(); ++i) {
+        unsigned d = static_cast<unsigned>(text[i] - '0');
+        if (d > 9)
+            return false;
+        if (value > (limit - d) / 10)
+            return false;
+        value = static_cast<U>(value * 10 + d);
+    }
+
+    out = negative ? static_cast<T>(static_cast<U>(0 - value)) : static_cast<T>(value);
+    return true;
+}
+
+template<typename T>
+bool decodeFixValue(std::string_view text, T& out)
+{
+    if constexpr (std::same_as<T, bool>) {
+        // FIX Boolean is 'Y' or 'N'
+        if (text.size() != 1 || (text[0] != 'Y' && text[0] != 'N'))
+            return false;
+        out = text[0] == 'Y';
+        return true;
+    } else if constexpr (std::same_as<T, char>) {
+        if (text.size() != 1)
+            return false;
+        out = text[0];
+        return true;
+    } else if constexpr (std::integral<T>) {
+        return decodeFixInteger(text, out);
+    } else if constexpr (std::floating_point<T>) {
+#if defined(__cpp_lib_to_chars)
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out, std::chars_format::fixed);
+        return ec == std::errc() && end == text.data() + text.size();
+#else
+        // Standard libraries without floating point from_chars
+        FixDecimal decimal;
+        if (!FixDecimal::parse(text, decimal))
+            return false;
+        out = static_cast<T>(decimal.toDouble());
+        return true;
+#endif
+    } else if constexpr (std::same_as<T, FixDecimal>) {
+        return FixDecimal::parse(text, out);
+    } else if constexpr (std::same_as<T, std::string_view>) {
+        out = text;
+        return true;
+    } else if constexpr (std::same_as<T, std::string>) {
+        // Whole value, including whitespace
+        out.assign(text);
+        return true;
+    } else {
+        std::istringstream iss{std::string(text)};
+        return static_cast<bool>(iss >> out);
+    }
+}
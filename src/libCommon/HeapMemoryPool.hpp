@@ -1,78 +1,199 @@
 #pragma once
+#include "Macros.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <new>
 #include <vector>
 #include <type_traits>
 #include <stdexcept>
-#include <algorithm>
+#include <sys/mman.h>
 
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+static const size_t PAGE_SIZE_BYTES = 4096;
+
+/*
+Growable pool of T built from fixed-size slabs that never move: growing adds a slab,
+so a pointer handed out stays valid until it is deallocated.
+Freed slots go on an intrusive free list and are reused first (LIFO, still warm in
+cache); slots never used yet are bumped out of the newest slab. allocate() is O(1);
+deallocate() is too, apart from checking the pointer, a binary search over the slabs.
+Slabs of 2 MiB and more are 2 MiB aligned and advised as transparent huge pages.
+reserve() adds and pre-faults slabs ahead of time, e.g. before the market opens, so
+the first burst does not pay for page faults. Not thread safe.
+*/
 template<typename T>
 class HeapMemoryPool {
-    std::byte* _buffer = nullptr;
-    size_t _capacity = 0;
-    std::vector<bool> _allocated;
+    struct Slab;
+    union Slot;
+    struct FreeSlot {
+        Slot* next;
+        Slab* slab;     // lets allocate() mark the slot without looking its slab up
+    };
+    union Slot {
+        FreeSlot free;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct Slab {
+        Slot* slots = nullptr;
+        size_t bytes = 0;
+        std::unique_ptr<uint64_t[]> allocated;      // one bit per slot, catches bad frees
+
+        ~Slab() { std::free(slots); }
+    };
+
+    size_t _slotsPerSlab;
+    std::vector<std::unique_ptr<Slab>> _slabs;      // sorted by address
+    Slot* _freeList = nullptr;
+    Slab* _bumpSlab = nullptr;      // newest slab, [_bumpNext, _slotsPerSlab) never used yet
+    size_t _bumpNext = 0;
+    size_t _size = 0;
 
 public:
-    explicit HeapMemoryPool(size_t initialCapacity)
-        : _capacity(initialCapacity), _allocated(initialCapacity, false) 
+    explicit HeapMemoryPool(size_t slotsPerSlab)
+        : _slotsPerSlab(std::max<size_t>(slotsPerSlab, 1))
     {
-        _buffer = static_cast<std::byte*>(std::aligned_alloc(alignof(T), sizeof(T) * _capacity));
-        if (!_buffer) throw std::bad_alloc();
+        addSlab();
     }
 
+    HeapMemoryPool(const HeapMemoryPool&) = delete;
+    HeapMemoryPool& operator=(const HeapMemoryPool&) = delete;
+    HeapMemoryPool(HeapMemoryPool&&) = delete;
+    HeapMemoryPool& operator=(HeapMemoryPool&&) = delete;
+
     ~HeapMemoryPool() {
         // Call destructors for allocated objects
-        for (size_t i = 0; i < _capacity; ++i) {
-            if (_allocated[i]) {
-                T* obj = reinterpret_cast<T*>(_buffer + i * sizeof(T));
-                obj->~T();
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (auto& slab : _slabs) {
+                for (size_t i = 0; i < _slotsPerSlab; ++i) {
+                    if (isAllocated(*slab, i))
+                        std::destroy_at(object(&slab->slots[i]));
+                }
             }
         }
-        std::free(_buffer);
     }
 
     template<typename... Args>
     T* allocate(Args&&... args) {
-        for (size_t i = 0; i < _capacity; ++i) {
-            if (!_allocated[i]) {
-                void* place = _buffer + i * sizeof(T);
-                T* obj = new(place) T(std::forward<Args>(args)...);
-                _allocated[i] = true;
-                return obj;
-            }
+        Slab* slab;
+        Slot* slot = takeSlot(slab);
+        T* obj;
+        try {
+            obj = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pushFree(slot, slab);
+            throw;
         }
-        // Optional: grow pool dynamically
-        grow();
-        return allocate(std::forward<Args>(args)...);
+        setAllocated(*slab, static_cast<size_t>(slot - slab->slots), true);
+        ++_size;
+        return obj;
     }
 
     void deallocate(T* ptr) {
-        size_t idx = (reinterpret_cast<std::byte*>(ptr) - _buffer) / sizeof(T);
-        if (idx >= _capacity || !_allocated[idx])
+        Slab* slab = findSlab(ptr);
+        if (UNLIKELY(!slab))
             throw std::runtime_error("Invalid pointer deallocation");
-        ptr->~T();
-        _allocated[idx] = false;
+        size_t offset = address(ptr) - address(slab->slots);
+        size_t index = offset / sizeof(Slot);
+        if (UNLIKELY(offset % sizeof(Slot) != 0 || !isAllocated(*slab, index)))
+            throw std::runtime_error("Invalid pointer deallocation");
+        Slot* slot = &slab->slots[index];
+
+        std::destroy_at(ptr);
+        setAllocated(*slab, index, false);
+        pushFree(slot, slab);
+        --_size;
     }
 
+    // Adds slabs until capacity() >= capacity and touches their pages
+    void reserve(size_t capacity) {
+        while (this->capacity() < capacity) {
+            Slab& slab = addSlab();
+            auto* bytes = reinterpret_cast<volatile std::byte*>(slab.slots);
+            for (size_t offset = 0; offset < slab.bytes; offset += PAGE_SIZE_BYTES)
+                bytes[offset] = std::byte{0};
+        }
+    }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _slabs.size() * _slotsPerSlab; }
+    size_t slabCount() const { return _slabs.size(); }
+
 private:
-    void grow() {
-        size_t newCapacity = _capacity * 2;
-        std::byte* newBuffer = static_cast<std::byte*>(std::aligned_alloc(alignof(T), sizeof(T) * newCapacity));
-        if (!newBuffer) throw std::bad_alloc();
-
-        // Move existing objects to new buffer
-        for (size_t i = 0; i < _capacity; ++i) {
-            if (_allocated[i]) {
-                T* oldObj = reinterpret_cast<T*>(_buffer + i * sizeof(T));
-                T* newObj = new(newBuffer + i * sizeof(T)) T(std::move(*oldObj));
-                oldObj->~T();
-            }
+    static T* object(Slot* slot) { return std::launder(reinterpret_cast<T*>(slot->storage)); }
+
+    static bool isAllocated(const Slab& slab, size_t index) {
+        return (slab.allocated[index / 64] >> (index % 64)) & 1;
+    }
+
+    static void setAllocated(Slab& slab, size_t index, bool allocated) {
+        uint64_t bit = 1ULL << (index % 64);
+        if (allocated)
+            slab.allocated[index / 64] |= bit;
+        else
+            slab.allocated[index / 64] &= ~bit;
+    }
+
+    Slot* takeSlot(Slab*& slab) {
+        if (LIKELY(_freeList != nullptr)) {
+            Slot* slot = _freeList;
+            _freeList = slot->free.next;
+            slab = slot->free.slab;
+            return slot;
         }
+        if (UNLIKELY(_bumpNext == _slotsPerSlab))
+            addSlab();
+        slab = _bumpSlab;
+        return &_bumpSlab->slots[_bumpNext++];
+    }
+
+    void pushFree(Slot* slot, Slab* slab) {
+        slot->free = FreeSlot{_freeList, slab};
+        _freeList = slot;
+    }
+
+    Slab& addSlab() {
+        // Big slabs start on a huge page boundary, small ones on a cache line
+        size_t bytes = _slotsPerSlab * sizeof(Slot);
+        size_t alignment = bytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : std::max<size_t>(alignof(Slot), CACHE_LINE_SIZE);
+        bytes = (bytes + alignment - 1) / alignment * alignment;
+
+        auto slab = std::make_unique<Slab>();
+        slab->slots = static_cast<Slot*>(std::aligned_alloc(alignment, bytes));
+        if (!slab->slots)
+            throw std::bad_alloc();
+        slab->bytes = bytes;
+        slab->allocated = std::make_unique<uint64_t[]>((_slotsPerSlab + 63) / 64);
+#ifdef MADV_HUGEPAGE
+        if (alignment == HUGE_PAGE_SIZE)
+            madvise(slab->slots, bytes, MADV_HUGEPAGE);     // a hint, fine if refused
+#endif
+
+        // Slots left in the previous bump slab go to the free list so none are lost
+        if (_bumpSlab) {
+            for (size_t i = _bumpNext; i < _slotsPerSlab; ++i)
+                pushFree(&_bumpSlab->slots[i], _bumpSlab);
+        }
+        _bumpSlab = slab.get();
+        _bumpNext = 0;
+
+        auto position = std::upper_bound(_slabs.begin(), _slabs.end(), address(slab->slots), byAddress);
+        return **_slabs.insert(position, std::move(slab));
+    }
+
+    // Pointers into different slabs are compared as integers
+    static uintptr_t address(const void* ptr) { return reinterpret_cast<uintptr_t>(ptr); }
+    static bool byAddress(uintptr_t ptr, const std::unique_ptr<Slab>& slab) { return ptr < address(slab->slots); }
 
-        std::free(_buffer);
-        _buffer = newBuffer;
-        _allocated.resize(newCapacity, false);
-        _capacity = newCapacity;
+    // Slab whose slots contain ptr, nullptr if none
+    Slab* findSlab(const void* ptr) const {
+        auto after = std::upper_bound(_slabs.begin(), _slabs.end(), address(ptr), byAddress);
+        if (after == _slabs.begin())
+            return nullptr;
+        Slab* slab = (after - 1)->get();
+        return address(ptr) < address(slab->slots + _slotsPerSlab) ? slab : nullptr;
     }
 };
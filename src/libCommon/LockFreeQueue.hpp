@@ -1,8 +1,17 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
-#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <expected>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include "Macros.h"
 
 // Memory order explanations:
@@ -17,49 +26,395 @@ concept PowerOfTwo = (N & (N - 1)) == 0;
 template<size_t N>
 concept ValidSize = NonZero<N> && PowerOfTwo<N> ;
 
+// Elements are constructed in place and destroyed when consumed, they need not be
+// copyable, movable or default constructible
 template <typename T>
 concept ValidQueueElement =
-    std::default_initializable<T>;
+    std::destructible<T> && !std::is_reference_v<T> && !std::is_array_v<T>;
 
-template<typename T, size_t N>
+// Who may call the producer and consumer sides concurrently, see LockFreeQueue
+namespace QueuePolicy
+{
+    struct SPSC {};     // one producer thread, one consumer thread
+    struct MPSC {};     // any number of producers, one consumer thread
+    struct MPMC {};     // any number of producers and consumers
+}
+
+/*
+LockFreeQueue<T, N> (QueuePolicy::SPSC): single producer, single consumer ring of N - 1 elements.
+Slots are raw storage: emplace()/try_push() construct the element in its slot and
+consume() hands it to the consumer in place before destroying it, so nothing is
+default constructed up front and nothing is copied out. Trivially copyable elements
+are moved in and out with memcpy.
+Head and tail sit on cache lines of their own, next to the owning side's copy of the
+other index. That copy is only refreshed when the queue looks full (producer) or
+empty (consumer), so most calls do not touch the other side's cache line at all.
+
+The bulk calls move a burst with one index update per side instead of one per element.
+
+    queue.emplace(id, "text");                          // producer
+    queue.consume([](Order& order) { handle(order); }); // consumer
+    queue.read_available([](std::span<Order> orders) { handleAll(orders); });
+*/
+template<typename T, size_t N, typename Policy = QueuePolicy::SPSC>
 requires ValidSize<N> && ValidQueueElement<T>
 class LockFreeQueue {
+    static constexpr size_t MASK = N - 1;
+    static constexpr bool TRIVIAL = std::is_trivially_copyable_v<T>;
+
+    struct alignas(T) Slot {
+        std::byte bytes[sizeof(T)];
+    };
+
 public:
     LockFreeQueue() = default;
     LockFreeQueue(const LockFreeQueue&) = delete;
     LockFreeQueue& operator=(const LockFreeQueue&) = delete;
     LockFreeQueue(LockFreeQueue&&) = delete;
     LockFreeQueue& operator=(LockFreeQueue&&) = delete;
-    ~LockFreeQueue() = default;
 
-    std::expected<bool, std::string> enqueue(const T& item) {
+    // Not thread safe, both sides must be done with the queue
+    ~LockFreeQueue() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (consume([](T&) {}))
+                ;
+        }
+    }
+
+    // Producer side: constructs T from args in the next slot, false when the queue is full
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    bool emplace(Args&&... args) {
         size_t t = _tail.load(std::memory_order_relaxed);
-        size_t h = _head.load(std::memory_order_acquire);
+        size_t next = (t + 1) & MASK;
+        if (UNLIKELY(next == _cachedHead)) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (next == _cachedHead)
+                return false;
+        }
 
-        if (((t + 1) % N) == h)
-            return std::unexpected("LockFreeQueue: Queue is full");
+        void* slot = _buffer[t].bytes;
+        if constexpr (TRIVIAL && sizeof...(Args) == 1 && (std::same_as<std::remove_cvref_t<Args>, T> && ...)) {
+            std::memcpy(slot, std::addressof(args)..., sizeof(T));
+        } else {
+            ::new (slot) T(std::forward<Args>(args)...);
+        }
 
-        memcpy(&_buffer[t], &item, sizeof(T));
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
 
-        _tail.store((t + 1) & (N - 1), std::memory_order_release);
+    bool try_push(T&& item) requires std::move_constructible<T> {
+        return emplace(std::move(item));
+    }
+
+    bool try_push(const T& item) requires std::copy_constructible<T> {
+        return emplace(item);
+    }
+
+    // Consumer side: calls fn(T&) on the oldest element, then destroys it.
+    // false when the queue is empty, fn is not called then.
+    template<typename Fn>
+    requires std::invocable<Fn&, T&>
+    bool consume(Fn&& fn) {
+        size_t h = _head.load(std::memory_order_relaxed);
+        if (!readable(h))
+            return false;
+
+        T* item = element(h);
+        fn(*item);
+        std::destroy_at(item);
+
+        _head.store((h + 1) & MASK, std::memory_order_release);
         return true;
     }
 
-    std::expected<bool, std::string> dequeue(T& item) {
+    // Producer side: copies as many of items as fit, publishes them at once. Returns how many.
+    size_t enqueue_bulk(std::span<const T> items) requires std::copy_constructible<T> {
+        size_t t = _tail.load(std::memory_order_relaxed);
+        size_t count = std::min(items.size(), writable(t, items.size()));
+        if (count == 0)
+            return 0;
+
+        // At most two runs of slots: up to the end of the ring, then from its start
+        size_t first = std::min(count, N - t);
+        if constexpr (TRIVIAL) {
+            std::memcpy(_buffer[t].bytes, items.data(), first * sizeof(T));
+            std::memcpy(_buffer[0].bytes, items.data() + first, (count - first) * sizeof(T));
+        } else {
+            for (size_t i = 0; i < count; ++i)
+                ::new (_buffer[(t + i) & MASK].bytes) T(items[i]);
+        }
+
+        _tail.store((t + count) & MASK, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer side: moves up to max elements into out, frees their slots at once. Returns how many.
+    size_t dequeue_bulk(std::span<T> out, size_t max = SIZE_MAX) requires std::is_move_assignable_v<T> {
+        size_t index = 0;
+        read_available([&](std::span<T> run) {
+            if constexpr (TRIVIAL) {
+                std::memcpy(static_cast<void*>(out.data() + index), run.data(), run.size() * sizeof(T));
+                index += run.size();
+            } else {
+                for (T& item : run)
+                    out[index++] = std::move(item);
+            }
+        }, std::min(max, out.size()));
+        return index;
+    }
+
+    /*
+    Consumer side, zero copy: calls fn(std::span<T>) on up to max queued elements where
+    they lie. A range that wraps around the end of the ring comes as two calls. The
+    elements are destroyed and their slots freed once fn has seen all of them.
+    Returns how many were handed out.
+    */
+    template<typename Fn>
+    requires std::invocable<Fn&, std::span<T>>
+    size_t read_available(Fn&& fn, size_t max = SIZE_MAX) {
         size_t h = _head.load(std::memory_order_relaxed);
-        size_t t = _tail.load(std::memory_order_acquire);
+        size_t count = std::min(max, readableCount(h, max));
+        if (count == 0)
+            return 0;
+
+        size_t first = std::min(count, N - h);
+        fn(std::span<T>(element(h), first));
+        if (count > first)
+            fn(std::span<T>(element(0), count - first));
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < count; ++i)
+                std::destroy_at(element((h + i) & MASK));
+        }
+        _head.store((h + count) & MASK, std::memory_order_release);
+        return count;
+    }
+
+    std::expected<bool, std::string_view> enqueue(const T& item) requires std::copy_constructible<T> {
+        if (!emplace(item))
+            return std::unexpected("LockFreeQueue: Queue is full");
+        return true;
+    }
 
-        if (h == t)
+    std::expected<bool, std::string_view> enqueue(T&& item) requires std::move_constructible<T> {
+        if (!emplace(std::move(item)))
+            return std::unexpected("LockFreeQueue: Queue is full");
+        return true;
+    }
+
+    // Moves the oldest element into item
+    std::expected<bool, std::string_view> dequeue(T& item) requires std::is_move_assignable_v<T> {
+        bool consumed = consume([&item](T& queued) {
+            if constexpr (TRIVIAL)
+                std::memcpy(static_cast<void*>(std::addressof(item)), &queued, sizeof(T));
+            else
+                item = std::move(queued);
+        });
+        if (!consumed)
             return std::unexpected("LockFreeQueue: Queue is empty");
+        return true;
+    }
 
-        memcpy(&item, &_buffer[h], sizeof(T)); // safe: only consumer reads h
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
 
-        _head.store((h + 1) & (N - 1), std::memory_order_release);
+    // Consumer side: oldest element without removing it, nullptr when the queue is empty.
+    // The element stays valid until pop().
+    const T* peek() {
+        size_t h = _head.load(std::memory_order_relaxed);
+        if (!readable(h))
+            return nullptr;
+        return element(h);
+    }
+
+    // Consumer side: destroys the element returned by peek()
+    void pop() {
+        size_t h = _head.load(std::memory_order_relaxed);
+        std::destroy_at(element(h));
+        _head.store((h + 1) & MASK, std::memory_order_release);
+    }
+
+private:
+    // Consumer side: whether slot h holds an element, reads _tail only when the cached copy says empty
+    bool readable(size_t h) {
+        if (LIKELY(h != _cachedTail))
+            return true;
+        _cachedTail = _tail.load(std::memory_order_acquire);
+        return h != _cachedTail;
+    }
+
+    // Producer side: free slots from t, reads _head only when the cached copy leaves fewer than wanted
+    size_t writable(size_t t, size_t wanted) {
+        size_t free = (_cachedHead - t - 1) & MASK;
+        if (free < wanted) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            free = (_cachedHead - t - 1) & MASK;
+        }
+        return free;
+    }
+
+    // Consumer side: queued elements from h, same refresh rule as writable()
+    size_t readableCount(size_t h, size_t wanted) {
+        size_t queued = (_cachedTail - h) & MASK;
+        if (queued < wanted) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            queued = (_cachedTail - h) & MASK;
+        }
+        return queued;
+    }
+
+    T* element(size_t index) { return std::launder(reinterpret_cast<T*>(_buffer[index].bytes)); }
+    const T* element(size_t index) const { return std::launder(reinterpret_cast<const T*>(_buffer[index].bytes)); }
+
+    // Consumer's line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head = 0;
+    size_t _cachedTail = 0;
+    // Producer's line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail = 0;
+    size_t _cachedHead = 0;
+    alignas(CACHE_LINE_SIZE) Slot _buffer[N];
+};
+
+/*
+Bounded ring for more than one producer, and with MultiConsumer more than one consumer
+(D. Vyukov's MPMC queue). Every slot carries a sequence number saying whose turn it
+is: a producer may write slot i of lap k when it reads i + k*N, a consumer may read it
+at i + k*N + 1. Producers claim a position with a CAS on _tail, consumers with one on
+_head, or with a plain store when there is only one consumer. All N slots are usable.
+Use it through LockFreeQueue<T, N, QueuePolicy::MPSC> or QueuePolicy::MPMC.
+*/
+template<typename T, size_t N, bool MultiConsumer>
+requires ValidSize<N> && ValidQueueElement<T>
+class SequencedQueue {
+    static constexpr size_t MASK = N - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) std::byte bytes[sizeof(T)];
+    };
+
+public:
+    SequencedQueue() {
+        for (size_t i = 0; i < N; ++i)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    SequencedQueue(const SequencedQueue&) = delete;
+    SequencedQueue& operator=(const SequencedQueue&) = delete;
+    SequencedQueue(SequencedQueue&&) = delete;
+    SequencedQueue& operator=(SequencedQueue&&) = delete;
+
+    // Not thread safe, every thread must be done with the queue
+    ~SequencedQueue() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (consume([](T&) {}))
+                ;
+        }
+    }
+
+    // Any producer: constructs T from args in the claimed slot, false when the queue is full
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    bool emplace(Args&&... args) {
+        size_t pos = _tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;   // the slot still holds the element from the previous lap
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void*>(cell->bytes)) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
         return true;
     }
 
+    bool try_push(T&& item) requires std::move_constructible<T> {
+        return emplace(std::move(item));
+    }
+
+    bool try_push(const T& item) requires std::copy_constructible<T> {
+        return emplace(item);
+    }
+
+    // Consumer: calls fn(T&) on the oldest element, then destroys it. false when empty.
+    template<typename Fn>
+    requires std::invocable<Fn&, T&>
+    bool consume(Fn&& fn) {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if constexpr (MultiConsumer) {
+                    if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else {
+                    _head.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // not written yet
+            } else {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* item = std::launder(reinterpret_cast<T*>(cell->bytes));
+        fn(*item);
+        std::destroy_at(item);
+        // Free for the producer of the next lap
+        cell->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    std::expected<bool, std::string_view> enqueue(const T& item) requires std::copy_constructible<T> {
+        if (!emplace(item))
+            return std::unexpected("LockFreeQueue: Queue is full");
+        return true;
+    }
+
+    std::expected<bool, std::string_view> enqueue(T&& item) requires std::move_constructible<T> {
+        if (!emplace(std::move(item)))
+            return std::unexpected("LockFreeQueue: Queue is full");
+        return true;
+    }
+
+    // Moves the oldest element into item
+    std::expected<bool, std::string_view> dequeue(T& item) requires std::is_move_assignable_v<T> {
+        if (!consume([&item](T& queued) { item = std::move(queued); }))
+            return std::unexpected("LockFreeQueue: Queue is empty");
+        return true;
+    }
+
+    // A snapshot, other threads may change it right after
+    bool empty() const {
+        size_t pos = _head.load(std::memory_order_acquire);
+        return _cells[pos & MASK].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
 private:
-    std::atomic<size_t> _head = 0;
-    std::atomic<size_t> _tail = 0;
-    std::array<T, N> _buffer;
-};
\ No newline at end of file
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail = 0;    // producers' line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head = 0;    // consumers' line
+    alignas(CACHE_LINE_SIZE) Cell _cells[N];
+};
+
+template<typename T, size_t N>
+requires ValidSize<N> && ValidQueueElement<T>
+class LockFreeQueue<T, N, QueuePolicy::MPSC> : public SequencedQueue<T, N, false> {};
+
+template<typename T, size_t N>
+requires ValidSize<N> && ValidQueueElement<T>
+class LockFreeQueue<T, N, QueuePolicy::MPMC> : public SequencedQueue<T, N, true> {};
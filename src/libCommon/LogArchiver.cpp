@@ -0,0 +1,84 @@
+#include "LogArchiver.h"
+#include <filesystem>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <zlib.h>
+
+namespace fs = std::filesystem;
+
+static const size_t LOG_ARCHIVE_CHUNK_SIZE = 64 * 1024;
+
+LogArchiver::LogArchiver(std::string archiveDir)
+    : _archiveDir(std::move(archiveDir))
+{
+    _thread = std::jthread([this](std::stop_token st) { run(st); });
+}
+
+void LogArchiver::archive(std::string path)
+{
+    {
+        std::lock_guard lock(_mutex);
+        _pending.push_back(std::move(path));
+    }
+    _ready.notify_one();
+}
+
+void LogArchiver::run(std::stop_token st)
+{
+    // Only runs when no other thread wants the CPU, the kernel also gives it idle I/O
+    // priority. Not fatal if refused, the work is just done at normal priority.
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+    while (true) {
+        std::string path;
+        {
+            std::unique_lock lock(_mutex);
+            _ready.wait(lock, st, [this] { return !_pending.empty(); });
+            if (_pending.empty())
+                return;     // stop requested and nothing left to do
+            path = std::move(_pending.front());
+            _pending.pop_front();
+        }
+        archiveNow(path);
+    }
+}
+
+void LogArchiver::archiveNow(const std::string& path)
+{
+    //1. Move out of the live directory first, so nothing picks it up as the current log
+    std::error_code ec;
+    fs::path moved = fs::path(_archiveDir) / fs::path(path).filename();
+    fs::rename(path, moved, ec);
+    if (ec)
+        return;
+
+    //2. Compress next to it. On failure the plain file stays in the archive.
+    std::string target = moved.string() + ".gz";
+    if (compress(moved.string(), target))
+        fs::remove(moved, ec);
+    else
+        fs::remove(target, ec);
+}
+
+bool LogArchiver::compress(const std::string& source, const std::string& target)
+{
+    std::ifstream in(source, std::ios::binary);
+    if (!in)
+        return false;
+    gzFile out = gzopen(target.c_str(), "wb6");
+    if (!out)
+        return false;
+
+    std::string chunk(LOG_ARCHIVE_CHUNK_SIZE, '\0');
+    bool ok = true;
+    while (ok && in) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        std::streamsize n = in.gcount();
+        if (n > 0)
+            ok = gzwrite(out, chunk.data(), static_cast<unsigned>(n)) == n;
+    }
+    ok &= !in.bad();
+    return gzclose(out) == Z_OK && ok;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*
+Moves closed log files into the archive directory and gzips them there, on its own
+thread at idle priority so the logger's writer never waits on the disk for it.
+archive() only queues the path. Files still queued when the archiver is destroyed
+are compressed before its thread exits.
+*/
+class LogArchiver {
+    std::string _archiveDir;
+    std::mutex _mutex;
+    std::condition_variable_any _ready;
+    std::deque<std::string> _pending;
+    std::jthread _thread;
+
+    void run(std::stop_token st);
+    void archiveNow(const std::string& path);
+
+public:
+    explicit LogArchiver(std::string archiveDir);
+
+    // Takes ownership of a closed file, returns immediately
+    void archive(std::string path);
+
+    // Writes source gzipped to target, false if either file cannot be used
+    static bool compress(const std::string& source, const std::string& target);
+
+    LogArchiver(const LogArchiver&) = delete;
+    LogArchiver& operator=(const LogArchiver&) = delete;
+};
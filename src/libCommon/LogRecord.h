@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+// One queue slot, header included
+static const size_t LOG_RECORD_SIZE = 512;
+
+enum class LogLevel
+{
+    TRACE,
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR
+};
+
+/*
+Binary encoding of log arguments.
+The logging thread copies each argument's raw bytes into the record, the writer
+thread decodes them and runs std::format. Strings are stored as a length followed by
+their bytes and are cut short when the record is full; everything else is a memcpy.
+*/
+namespace LogArgs
+{
+    template<typename T>
+    concept StringLike = std::convertible_to<const T&, std::string_view>;
+
+    template<typename T>
+    concept Loggable = StringLike<T> || std::is_arithmetic_v<T> || std::is_pointer_v<T>;
+
+    // What the writer thread formats in place of T
+    template<typename T>
+    using Decoded = std::conditional_t<StringLike<T>, std::string_view,
+                    std::conditional_t<std::is_pointer_v<T>, const void*, T>>;
+
+    // Bytes an argument always takes, a string's bytes come on top
+    template<typename T>
+    constexpr size_t fixedSize() { return StringLike<T> ? sizeof(uint32_t) : sizeof(Decoded<T>); }
+
+    // room excludes what the fixed part of the arguments still to come needs
+    template<typename T>
+    void encode(char*& pos, size_t room, const T& value)
+    {
+        if constexpr (StringLike<T>) {
+            std::string_view text(value);
+            uint32_t length = static_cast<uint32_t>(std::min<size_t>(text.size(), room - sizeof(uint32_t)));
+            std::memcpy(pos, &length, sizeof(length));
+            std::memcpy(pos + sizeof(length), text.data(), length);
+            pos += sizeof(length) + length;
+        } else {
+            Decoded<T> stored = static_cast<Decoded<T>>(value);
+            std::memcpy(pos, &stored, sizeof(stored));
+            pos += sizeof(stored);
+        }
+    }
+
+    template<typename T>
+    Decoded<T> decode(const char*& pos)
+    {
+        if constexpr (StringLike<T>) {
+            uint32_t length;
+            std::memcpy(&length, pos, sizeof(length));
+            std::string_view text(pos + sizeof(length), length);
+            pos += sizeof(length) + length;
+            return text;
+        } else {
+            Decoded<T> stored;
+            std::memcpy(&stored, pos, sizeof(stored));
+            pos += sizeof(stored);
+            return stored;
+        }
+    }
+
+    // Returns the number of bytes written to out
+    template<typename... Args>
+    size_t encodeAll(char* out, size_t capacity, const Args&... args)
+    {
+        // after[i]: fixed bytes of the arguments behind argument i
+        constexpr std::array<size_t, sizeof...(Args) + 1> after = [] {
+            std::array<size_t, sizeof...(Args) + 1> sizes = {fixedSize<Args>()..., 0};
+            std::array<size_t, sizeof...(Args) + 1> result{};
+            for (size_t i = sizeof...(Args); i-- > 0;)
+                result[i] = i + 1 < sizeof...(Args) ? result[i + 1] + sizes[i + 1] : 0;
+            return result;
+        }();
+
+        char* pos = out;
+        size_t index = 0;
+        ((encode(pos, capacity - static_cast<size_t>(pos - out) - after[index++], args)), ...);
+        return static_cast<size_t>(pos - out);
+    }
+
+    template<typename... Args>
+    void render(std::string& out, std::string_view format, const char* args)
+    {
+        const char* pos = args;
+        // Braced initialization decodes left to right
+        std::tuple<Decoded<Args>...> values{decode<Args>(pos)...};
+        std::apply([&](auto&... decoded) {
+            std::vformat_to(std::back_inserter(out), format, std::make_format_args(decoded...));
+        }, values);
+    }
+}
+
+using LogRenderFn = void (*)(std::string& out, std::string_view format, const char* args);
+
+/*
+What a LOG_* call puts in the queue: no std::string, nothing to allocate, trivially
+copyable. format points to the call site's string literal and render to the decoder
+instantiated for the call site's argument types.
+*/
+struct LogRecord {
+    LogLevel level = LogLevel::INFO;
+    uint32_t argsSize = 0;
+    std::thread::id threadId;
+    uint64_t timestampNs = 0;       // since the Unix epoch
+    std::source_location location;
+    std::string_view format;
+    LogRenderFn render = nullptr;
+    char args[LOG_RECORD_SIZE - 64];
+};
+
+static const size_t LOG_RECORD_ARGS_SIZE = sizeof(LogRecord::args);
+
+static_assert(std::is_trivially_copyable_v<LogRecord>, "LogRecord is copied into the queue with memcpy");
+static_assert(sizeof(LogRecord) <= LOG_RECORD_SIZE, "LogRecord: header grew, shrink args");
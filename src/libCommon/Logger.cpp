@@ -1,80 +1,318 @@
 #include "Logger.h"
 #include <cassert>
-#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <filesystem>
 #include <format>
 #include <chrono>
+#include <algorithm>
 
 namespace fs = std::filesystem;
 
-void Logger::print(LogLevel level, const std::string& message)
+namespace {
+    // Functions rather than globals, the logger may be used during static initialization
+    std::string logDir() { return std::string(SOURCE_ROOT) + "/logs/"; }
+    std::string logArchiveDir() { return logDir() + "archive/"; }
+}
+
+Logger::QueueSlot* Logger::claimSlot()
 {
-    if (level < _currentLogLevel)
-        return;
-    
-    auto result = _logQueue.enqueue(LogData{
-                                        level, 
-                                        message, 
-                                        __TIMESTAMP__, 
-                                        std::this_thread::get_id(), 
-                                        __FILE_NAME__, 
-                                        __LINE__});
-    if (UNLIKELY(!result.has_value())) 
+    //1. Reuse the queue of a thread that has exited, once the writer has emptied it
+    size_t used = std::min(_slotsUsed.load(std::memory_order_acquire), LOG_MAX_THREADS);
+    for (size_t i = 0; i < used; ++i) {
+        QueueSlot& slot = _slots[i];
+        LogQueue* queue = slot.queue.load(std::memory_order_acquire);
+        bool expected = false;
+        if (queue && !slot.owned.load(std::memory_order_relaxed) && queue->empty()
+            && slot.owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return &slot;
+    }
+
+    //2. Otherwise a new one, nullptr once all are taken
+    size_t index = _slotsUsed.fetch_add(1, std::memory_order_acq_rel);
+    if (index >= LOG_MAX_THREADS)
+        return nullptr;
+    _queues[index] = std::make_unique<LogQueue>();
+    _slots[index].owned.store(true, std::memory_order_relaxed);
+    _slots[index].queue.store(_queues[index].get(), std::memory_order_release);
+    return &_slots[index];
+}
+
+void Logger::enqueue(const LogRecord& record)
+{
+    // Gives the thread's queue back when the thread exits
+    struct ThreadHandle {
+        QueueSlot* slot = nullptr;
+        bool registered = false;
+        ~ThreadHandle() {
+            if (slot)
+                slot->owned.store(false, std::memory_order_release);
+        }
+    };
+    thread_local ThreadHandle handle;
+
+    if (UNLIKELY(!handle.registered)) {
+        handle.slot = claimSlot();
+        handle.registered = true;
+    }
+
+    bool queued;
+    if (LIKELY(handle.slot != nullptr)) {
+        queued = handle.slot->queue.load(std::memory_order_relaxed)->emplace(record);
+    } else {
+        while (_sharedQueueLock.test_and_set(std::memory_order_acquire))
+            ;
+        queued = _sharedQueue.emplace(record);
+        _sharedQueueLock.clear(std::memory_order_release);
+    }
+
+    if (UNLIKELY(!queued)) 
     {
         assert(false && "Logger: Log queue is full, message dropped");
     }
+
+    // Only costs a notify while the writer sleeps
+    _writerWait.notify();
+}
+
+size_t Logger::drain(bool& sawError)
+{
+    std::array<LogQueue*, LOG_MAX_THREADS + 1> queues;
+    size_t count = 0;
+    for (auto& slot : _slots) {
+        if (LogQueue* queue = slot.queue.load(std::memory_order_acquire))
+            queues[count++] = queue;
+    }
+    queues[count++] = &_sharedQueue;
+
+    // k-way merge: the oldest record at the head of any queue goes first
+    size_t written = 0;
+    while (true) {
+        LogQueue* oldestQueue = nullptr;
+        const LogRecord* oldest = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            const LogRecord* head = queues[i]->peek();
+            if (head && (!oldest || head->timestampNs < oldest->timestampNs)) {
+                oldest = head;
+                oldestQueue = queues[i];
+            }
+        }
+        if (!oldest)
+            return written;
+
+        appendLogLine(*oldest);
+        sawError |= oldest->level == LogLevel::ERROR;
+        oldestQueue->pop();
+        ++written;
+
+        if (_batch.size() >= LOG_WRITE_BATCH_SIZE)
+            writeBatch();
+    }
+}
+
+bool Logger::anyQueued() const
+{
+    for (auto& slot : _slots) {
+        LogQueue* queue = slot.queue.load(std::memory_order_acquire);
+        if (queue && !queue->empty())
+            return true;
+    }
+    return !_sharedQueue.empty();
+}
+
+void Logger::writeBatch()
+{
+    rotateIfDue();
+
+    // One write per batch, looping only on partial writes
+    size_t done = 0;
+    while (done < _batch.size()) {
+        ssize_t n = ::write(_fd, _batch.data() + done, _batch.size() - done);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            assert(false && "Logger: Unable to write to log file");
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    _fileBytes += done;
+    _batch.clear();
+}
+
+void Logger::rotateIfDue()
+{
+    // A batch never goes to a file of its own when the current one is still empty
+    if (_fileBytes == 0)
+        return;
+
+    uint64_t maxBytes = _rotateBytes.load(std::memory_order_relaxed);
+    uint32_t maxSeconds = _rotateSeconds.load(std::memory_order_relaxed);
+    bool due = (maxBytes != 0 && _fileBytes + _batch.size() > maxBytes)
+            || (maxSeconds != 0 && std::chrono::steady_clock::now() - _fileOpenedAt >= std::chrono::seconds(maxSeconds));
+    if (!due)
+        return;
+
+    std::string closed = getLogFileName();
+    std::string next = nextLogFileName();
+    ::close(_fd);
+    if (!openLogFile(next)) {
+        assert(false && "Logger: Unable to open rotated log file for writing");
+        return;
+    }
+    {
+        std::lock_guard lock(_fileNameMutex);
+        _logFileName = next;
+    }
+    _archiver.archive(std::move(closed));
+}
+
+bool Logger::openLogFile(const std::string& fileName)
+{
+    _fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    _fileBytes = 0;
+    _fileOpenedAt = std::chrono::steady_clock::now();
+    return _fd >= 0;
+}
+
+std::string Logger::nextLogFileName()
+{
+    // Opening time first, then a sequence so files rotated within the same second sort in order
+    using namespace std::chrono;
+    auto now = floor<seconds>(system_clock::now());
+    return std::format("{}{:%Y%m%d_%H%M%S}_{:04}.log", _logFileStem, now, _fileSequence++);
+}
+
+void Logger::writerLoop(std::stop_token st)
+{
+    if (!openLogFile(getLogFileName())) {
+        assert(false && "Logger: Unable to open log file for writing");
+        return;
+    }
+
+    _batch.reserve(LOG_WRITE_BATCH_SIZE + LOG_RECORD_SIZE * 4);
+    _batch += "----- Logger Started -----\n";
+    writeBatch();
+
+    auto lastWrite = std::chrono::steady_clock::now();
+    while (!st.stop_requested()) {
+        bool sawError = false;
+        if (drain(sawError) > 0) {
+            bool writeNow = false;
+            switch (_flushPolicy.load(std::memory_order_relaxed)) {
+                case LogFlushPolicy::PerBatch:
+                    writeNow = true;
+                    break;
+                case LogFlushPolicy::Interval:
+                    writeNow = std::chrono::steady_clock::now() - lastWrite
+                            >= std::chrono::milliseconds(_flushIntervalMs.load(std::memory_order_relaxed));
+                    break;
+                case LogFlushPolicy::OnError:
+                    writeNow = sawError;
+                    break;
+            }
+            if (writeNow) {
+                writeBatch();
+                lastWrite = std::chrono::steady_clock::now();
+            }
+            continue;
+        }
+
+        // Idle: the batch is kept while the writer spins and yields, a burst is often a
+        // few microseconds away. Interval still writes once its time is up, and whatever
+        // is left is written just before the writer goes to sleep.
+        auto flushDue = [&] {
+            return !_batch.empty() && _flushPolicy.load(std::memory_order_relaxed) == LogFlushPolicy::Interval
+                && std::chrono::steady_clock::now() - lastWrite
+                       >= std::chrono::milliseconds(_flushIntervalMs.load(std::memory_order_relaxed));
+        };
+        auto flush = [&] {
+            if (!_batch.empty()) {
+                writeBatch();
+                lastWrite = std::chrono::steady_clock::now();
+            }
+        };
+        if (flushDue())
+            flush();
+        _writerWait.waitUntil([&] { return anyQueued() || st.stop_requested() || flushDue(); }, flush);
+    }
+
+    _batch += "Logger stopping, flushing remaining log entries...\n";
+
+    // Drain remaining log entries
+    bool sawError = false;
+    drain(sawError);
+
+    _batch += "----- Logger Stopped -----\n";
+    writeBatch();
+    ::close(_fd);
 }
 
 void Logger::setLogLevel(LogLevel level)
 {
-    _currentLogLevel = level;
+    _currentLogLevel.store(level, std::memory_order_relaxed);
+}
+
+void Logger::setFlushPolicy(LogFlushPolicy policy, std::chrono::milliseconds interval)
+{
+    _flushIntervalMs.store(static_cast<uint32_t>(interval.count()), std::memory_order_relaxed);
+    _flushPolicy.store(policy, std::memory_order_relaxed);
 }
 
-LogLevel Logger::GetLogLevel() const
+void Logger::setRotation(uint64_t maxBytes, std::chrono::seconds interval)
 {
-    return _currentLogLevel;
+    _rotateBytes.store(maxBytes, std::memory_order_relaxed);
+    _rotateSeconds.store(static_cast<uint32_t>(interval.count()), std::memory_order_relaxed);
 }
 
-void Logger::writeLogToFile(std::ofstream& logFile, const LogData& logEntry)
+void Logger::appendLogLine(const LogRecord& logEntry)
 {
     switch (logEntry.level) {
         case LogLevel::TRACE:
-            logFile << "[TRACE] ";
+            _batch += "[TRACE] ";
             break;
         case LogLevel::DEBUG:
-            logFile << "[DEBUG] ";
+            _batch += "[DEBUG] ";
             break;
         case LogLevel::INFO:
-            logFile << "[INFO] ";
+            _batch += "[INFO] ";
             break;
         case LogLevel::WARN:
-            logFile << "[WARN] ";
+            _batch += "[WARN] ";
             break;
         case LogLevel::ERROR:
-            logFile << "[ERROR] ";
+            _batch += "[ERROR] ";
             break;
         default:
             break;
     }
-    logFile << "[" << logEntry.timestamp << "] "
-              << "[" << logEntry.threadId << "] "
-              << logEntry.message << " ("
-              << logEntry.fileName << ":"
-              << logEntry.lineNumber << ")\n";
 
-    logFile.flush();
+    // Only the microseconds are formatted per line, the date and time come from a cached prefix
+    _batch += '[';
+    _batch += _lineClock.format(logEntry.timestampNs);
+    auto out = std::back_inserter(_batch);
+    std::format_to(out, "] [{}] ", logEntry.threadId);
+
+    // Arguments are only turned into text here, on the writer thread
+    logEntry.render(_batch, logEntry.format, logEntry.args);
+
+    std::string_view fileName = logEntry.location.file_name();
+    fileName = fileName.substr(fileName.find_last_of('/') + 1);
+    std::format_to(out, " ({}:{})\n", fileName, logEntry.location.line());
 }
 
 std::string Logger::getLogFileName() const
 {
+    std::lock_guard lock(_fileNameMutex);
     return _logFileName;
 }
 
 void Logger::prepareLogFile()
 {
-    std::string logDir = std::string(SOURCE_ROOT) + "/logs/";
-    std::string archiveDir = logDir + "/archive/";
-    fs::exists(logDir) || fs::create_directories(logDir);
+    std::string dir = logDir();
+    std::string archiveDir = logArchiveDir();
+    fs::exists(dir) || fs::create_directories(dir);
     fs::exists(archiveDir) || fs::create_directories(archiveDir);
 
     std::string fileName(LOG_FILE_NAME);
@@ -82,51 +320,22 @@ void Logger::prepareLogFile()
         fileName = "application";
     }
 
-    using namespace std::chrono;
-    auto now = floor<seconds>(system_clock::now());
-    std::string ts = std::format("{:%Y%m%d_%H%M%S}", now);
-
-    _logFileName =  logDir + fileName + "_" + ts + ".log";
-
+    _logFileStem = dir + fileName + "_";
+    _logFileName = nextLogFileName();
 }
+
 Logger::Logger()
-{   
+    : _archiver(logArchiveDir())
+{
     // Initialize log file name, create directories if needed
     prepareLogFile();
 
-    _writerThread = std::jthread([this](std::stop_token st){
-
-        std::ofstream logFile(_logFileName, std::ios::app);
-
-        if (!logFile.is_open()) {
-            assert(false && "Logger: Unable to open log file for writing");
-            return;
-        }
-
-        logFile << "----- Logger Started -----\n";
-        
-        LogData logEntry;
-        while (!st.stop_requested()) {
-            auto result = _logQueue.dequeue(logEntry);
-            if (result.has_value()) {
-                writeLogToFile(logFile, logEntry);  
-            } else {
-                // Sleep briefly to avoid busy-waiting
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
-        }
-        logFile << "Logger stopping, flushing remaining log entries...\n";
-
-        // Drain remaining log entries
-        while (_logQueue.dequeue(logEntry).has_value()) {
-            writeLogToFile(logFile, logEntry);
-        }
-
-        logFile << "----- Logger Stopped -----\n";
-        logFile.close();
-    });
+    _writerThread = std::jthread([this](std::stop_token st){ writerLoop(st); });
 }
 
 Logger::~Logger()
 {
-}
\ No newline at end of file
+    // The writer may be asleep, wake it so the jthread can join
+    _writerThread.request_stop();
+    _writerWait.wakeAll();
+}
@@ -1,84 +1,151 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <array>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <source_location>
 #include <string>
 #include <thread>
+#include "FixTimestamp.h"
+#include "LogArchiver.h"
+#include "WaitStrategy.hpp"
 #include "LockFreeQueue.hpp"
+#include "LogRecord.h"
 
-static const size_t LOG_MESSAGE_MAX_LENGTH = 1024; // 24 KB
+static const size_t LOG_MESSAGE_MAX_LENGTH = 1024; // queue slots per thread, LOG_RECORD_SIZE bytes each
+static const size_t LOG_MAX_THREADS = 64;           // threads with a queue of their own, any more share one
+static const size_t LOG_WRITE_BATCH_SIZE = 256 * 1024;  // formatted bytes buffered before a write()
+static const uint32_t LOG_WRITER_SPIN_ROUNDS = 2000;    // idle writer: pause this many rounds,
+static const uint32_t LOG_WRITER_YIELD_ROUNDS = 50;     // then yield this many, then sleep until woken
+static const uint64_t LOG_ROTATE_BYTES = 256ull * 1024 * 1024;  // default rotation size, see Logger::setRotation
+static const uint32_t LOG_ROTATE_SECONDS = 3600;                // default rotation interval
 
-enum class LogLevel
+// When the writer thread hands its buffered lines to the OS. It always does before it goes to sleep.
+enum class LogFlushPolicy
 {
-    TRACE,
-    DEBUG,
-    INFO,
-    WARN,
-    ERROR
+    PerBatch,   // after every drain of the queues
+    Interval,   // at most every flush interval, or when the buffer is full
+    OnError     // when an ERROR line is buffered, or when the buffer is full
 };
-#define LOG_TRACE(MSG) \
-    do { \
-        if (Logger::getInstance().GetLogLevel() <= LogLevel::TRACE) { \
-            Logger::getInstance().print(LogLevel::TRACE, MSG); \
-        } \
-    } while (0)
-#define LOG_DEBUG(MSG) \
-    do { \
-        if (Logger::getInstance().GetLogLevel() <= LogLevel::DEBUG) { \
-            Logger::getInstance().print(LogLevel::DEBUG, MSG); \
-        } \
-    } while (0)
-#define LOG_INFO(MSG) \
-    do { \
-        if (Logger::getInstance().GetLogLevel() <= LogLevel::INFO) { \
-            Logger::getInstance().print(LogLevel::INFO, MSG); \
-        } \
-    } while (0)
-#define LOG_WARN(MSG) \
-    do { \
-        if (Logger::getInstance().GetLogLevel() <= LogLevel::WARN) { \
-            Logger::getInstance().print(LogLevel::WARN, MSG); \
-        } \
-    } while (0)
 
-#define LOG_ERROR(MSG) \
+/*
+LOG_INFO("order {} filled {} @ {}", clOrdId, qty, px);
+Only the level check runs when the level is off. Otherwise the arguments are copied
+into the queue as raw bytes and formatted later by the writer thread, see LogRecord.h.
+A single std::string argument is still accepted and logged as is.
+*/
+#define LOG_AT(LEVEL, ...) \
     do { \
-        if (Logger::getInstance().GetLogLevel() <= LogLevel::ERROR) { \
-            Logger::getInstance().print(LogLevel::ERROR, MSG); \
+        if (Logger::getInstance().GetLogLevel() <= LEVEL) { \
+            Logger::getInstance().log(LEVEL, std::source_location::current(), __VA_ARGS__); \
         } \
     } while (0)
+#define LOG_TRACE(...) LOG_AT(LogLevel::TRACE, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERROR, __VA_ARGS__)
 
 
 
+/*
+Every logging thread gets its own SPSC queue the first time it logs, so producers never
+share a cache line. The queue goes back to the pool when its thread exits and is
+reused by the next new thread. The writer thread drains all queues, always writing the
+oldest queued record first, so the file is in timestamp order as far as the records
+already queued at the time allow. Lines are formatted into one buffer and written
+with a single write() per batch, see LogFlushPolicy. An idle writer waits with
+WaitStrategy::Blocking: it spins, yields, then sleeps until a producer notifies it.
+The writer moves to a new file once the current one would exceed the rotation size or
+has been open for the rotation interval. It only switches between batches, so lines
+are never split or reordered across files. Closed files are handed to a LogArchiver,
+which gzips them into logs/archive/ on its own thread.
+*/
 class Logger {
 
-    struct LogData 
-    {
-        LogLevel level;
-        std::string message;
-        std::string timestamp;
-        std::__thread_id threadId;
-        std::string fileName;
-        int lineNumber;
+    using LogQueue = LockFreeQueue<LogRecord, LOG_MESSAGE_MAX_LENGTH>;
+
+    struct QueueSlot {
+        std::atomic<LogQueue*> queue = nullptr;     // published once, owned by _queues
+        std::atomic<bool> owned = false;            // a live thread produces into it
     };
-    
-    std::string _logFileName;
-    LockFreeQueue<LogData, LOG_MESSAGE_MAX_LENGTH> _logQueue;
-    LogLevel _currentLogLevel = LogLevel::INFO;
+
+    std::string _logFileStem;       // logs/<LOG_FILE_NAME>_, rotated files add time and sequence
+    std::string _logFileName;       // file being written, guarded by _fileNameMutex
+    mutable std::mutex _fileNameMutex;
+    std::array<QueueSlot, LOG_MAX_THREADS> _slots;
+    std::array<std::unique_ptr<LogQueue>, LOG_MAX_THREADS> _queues;
+    std::atomic<size_t> _slotsUsed = 0;
+    // Threads beyond LOG_MAX_THREADS take turns on this one
+    LogQueue _sharedQueue;
+    std::atomic_flag _sharedQueueLock;
+    std::atomic<LogLevel> _currentLogLevel = LogLevel::INFO;
+    std::atomic<LogFlushPolicy> _flushPolicy = LogFlushPolicy::PerBatch;
+    std::atomic<uint32_t> _flushIntervalMs = 100;
+    std::atomic<uint64_t> _rotateBytes = LOG_ROTATE_BYTES;
+    std::atomic<uint32_t> _rotateSeconds = LOG_ROTATE_SECONDS;
+
+    // Writer thread state: lines formatted but not written yet, and how it sleeps
+    std::string _batch;
+    FixTimestampFormatter _lineClock{FixTimePrecision::Micros};
+    WaitStrategy::Blocking<LOG_WRITER_SPIN_ROUNDS, LOG_WRITER_YIELD_ROUNDS> _writerWait;
+    int _fd = -1;
+    uint64_t _fileBytes = 0;
+    uint32_t _fileSequence = 0;
+    std::chrono::steady_clock::time_point _fileOpenedAt;
+
+    // Declared before the writer so it outlives it and takes the last rotated file
+    LogArchiver _archiver;
     std::jthread _writerThread;
 
     Logger();
-    void writeLogToFile(std::ofstream& logFile, const LogData& logEntry);
+    void enqueue(const LogRecord& record);
+    QueueSlot* claimSlot();
+    void writerLoop(std::stop_token st);
+    size_t drain(bool& sawError);
+    bool anyQueued() const;
+    void writeBatch();
+    void rotateIfDue();
+    bool openLogFile(const std::string& fileName);
+    std::string nextLogFileName();
+    void appendLogLine(const LogRecord& logEntry);
     void prepareLogFile();
 public:
-    
+
     void setLogLevel(LogLevel level);
-    LogLevel GetLogLevel() const;
-    void print(LogLevel level, const std::string& message);
+    void setFlushPolicy(LogFlushPolicy policy, std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+    // 0 turns off that trigger. Applies from the next batch the writer writes.
+    void setRotation(uint64_t maxBytes, std::chrono::seconds interval);
+    LogLevel GetLogLevel() const { return _currentLogLevel.load(std::memory_order_relaxed); }
+
+    // Captures format, location and argument bytes; formatting happens on the writer thread
+    template<typename... Args>
+    requires (LogArgs::Loggable<std::decay_t<Args>> && ...)
+    void log(LogLevel level, const std::source_location& location, std::format_string<Args...> format, Args&&... args);
+
+    // Message already built by the caller, logged through "{}"
+    template<typename Message>
+    requires std::same_as<std::remove_cvref_t<Message>, std::string>
+    void log(LogLevel level, const std::source_location& location, const Message& message) {
+        log<const std::string&>(level, location, "{}", message);
+    }
+
+    void print(LogLevel level, const std::string& message, const std::source_location& location = std::source_location::current()) {
+        if (level >= GetLogLevel())
+            log(level, location, message);
+    }
+
     static Logger& getInstance()
     {
         static Logger instance;
         return instance;
     }
 
+    // The file currently written, changes on rotation
     std::string getLogFileName() const;
 
     //delete copy/move constructors and assignment operators
@@ -87,4 +154,23 @@ public:
     Logger(Logger&&) = delete;
     Logger& operator=(Logger&&) = delete;
     ~Logger();
-};
\ No newline at end of file
+};
+
+template<typename... Args>
+requires (LogArgs::Loggable<std::decay_t<Args>> && ...)
+void Logger::log(LogLevel level, const std::source_location& location, std::format_string<Args...> format, Args&&... args)
+{
+    static_assert((LogArgs::fixedSize<std::decay_t<Args>>() + ... + 0) <= LOG_RECORD_ARGS_SIZE,
+                  "Logger: too many arguments for one record");
+
+    LogRecord record;
+    record.level = level;
+    record.threadId = std::this_thread::get_id();
+    record.timestampNs = FixClock::nowNs();
+    record.location = location;
+    record.format = format.get();
+    record.render = &LogArgs::render<std::decay_t<Args>...>;
+    record.argsSize = static_cast<uint32_t>(
+        LogArgs::encodeAll<std::decay_t<Args>...>(record.args, LOG_RECORD_ARGS_SIZE, args...));
+    enqueue(record);
+}
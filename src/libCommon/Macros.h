@@ -9,3 +9,25 @@
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #endif
+
+// Pause hint for spin loops, lets the sibling hyperthread run and saves power
+#ifndef CPU_RELAX
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__)
+#define CPU_RELAX() asm volatile("yield" ::: "memory")
+#else
+#define CPU_RELAX() ((void)0)
+#endif
+#endif
+
+// Alignment that keeps data written by different threads on different cache lines.
+// std::hardware_destructive_interference_size depends on -mtune, GCC warns against it in headers.
+#ifndef CACHE_LINE_SIZE
+#if defined(__aarch64__) && defined(__APPLE__)
+#define CACHE_LINE_SIZE 128
+#else
+#define CACHE_LINE_SIZE 64
+#endif
+#endif
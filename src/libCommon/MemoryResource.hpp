@@ -0,0 +1,202 @@
+#pragma once
+#include "Macros.h"
+#include "StaticMemoryPool.hpp"
+#include "HeapMemoryPool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+static const size_t MESSAGE_ARENA_INITIAL_BYTES = 16 * 1024;
+
+// Raw storage of one pool slot when a pool backs a memory_resource
+template<size_t Size, size_t Align = alignof(std::max_align_t)>
+struct alignas(Align) ResourceBlock {
+    std::byte bytes[Size];
+
+    ResourceBlock() {}      // not = default: the pools value-initialize, which would zero the bytes
+};
+
+/*
+std::pmr::memory_resource handing out the blocks of a StaticBlockPool or a HeapMemoryPool
+of ResourceBlock. Requests that do not fit one block go to the upstream resource; pmr
+passes the size back on deallocate, so no lookup is needed to tell the two apart.
+A full StaticMemoryPool throws std::bad_alloc, as memory resources do.
+The pool is not owned and, like the pools, the resource is not thread safe.
+
+    StaticBlockPool<64, 4096> pool;
+    PoolMemoryResource resource(pool);
+    std::pmr::vector<FixField> fields(&resource);
+*/
+template<typename Pool>
+class PoolMemoryResource : public std::pmr::memory_resource {
+    using Block = std::remove_pointer_t<decltype(std::declval<Pool&>().allocate())>;
+
+    Pool& _pool;
+    std::pmr::memory_resource* _upstream;
+
+    static bool fits(size_t bytes, size_t alignment) { return bytes <= sizeof(Block) && alignment <= alignof(Block); }
+
+public:
+    explicit PoolMemoryResource(Pool& pool, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : _pool(pool), _upstream(upstream) {}
+
+    Pool& pool() const { return _pool; }
+    std::pmr::memory_resource* upstream() const { return _upstream; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (UNLIKELY(!fits(bytes, alignment)))
+            return _upstream->allocate(bytes, alignment);
+        return _pool.allocate();
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (UNLIKELY(!fits(bytes, alignment)))
+            return _upstream->deallocate(ptr, bytes, alignment);
+        _pool.deallocate(static_cast<Block*>(ptr));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// StaticMemoryPool names its calls alloc()/free(), the resource wants allocate()/deallocate()
+template<size_t BlockSize, size_t Blocks>
+class StaticBlockPool : public StaticMemoryPool<ResourceBlock<BlockSize>, Blocks> {
+    using Base = StaticMemoryPool<ResourceBlock<BlockSize>, Blocks>;
+public:
+    ResourceBlock<BlockSize>* allocate() {
+        try {
+            return Base::alloc();
+        } catch (const std::runtime_error&) {
+            throw std::bad_alloc();
+        }
+    }
+    void deallocate(ResourceBlock<BlockSize>* block) { Base::free(block); }
+};
+
+template<size_t BlockSize, size_t Blocks>
+using StaticPoolResource = PoolMemoryResource<StaticBlockPool<BlockSize, Blocks>>;
+
+template<size_t BlockSize>
+using HeapPoolResource = PoolMemoryResource<HeapMemoryPool<ResourceBlock<BlockSize>>>;
+
+/*
+Monotonic arena for everything one message needs: FixMessage fields, group vectors,
+temporary strings. Allocation bumps a pointer, deallocate() does nothing, and reset()
+rewinds to the start in O(1) once the message is done.
+When the current chunk is full the next one is used, or taken from upstream at twice
+the size; reset() keeps every chunk, so an arena owned by a session stops calling
+malloc once it has seen its largest message. Everything allocated from the arena
+must be gone (or never touched again) before reset().
+
+    MessageArena arena;
+    for (;;) {
+        arena.reset();
+        FixMessage msg(&arena);
+        parser.parseInto(raw, msg);
+        ...
+    }
+*/
+class MessageArena : public std::pmr::memory_resource {
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    std::pmr::memory_resource* _upstream;
+    std::vector<Chunk> _chunks;
+    size_t _current = 0;        // chunk being bumped
+    std::byte* _next = nullptr;
+    std::byte* _end = nullptr;
+    size_t _used = 0;           // bytes handed out by the chunks before _current
+
+public:
+    explicit MessageArena(size_t initialBytes = MESSAGE_ARENA_INITIAL_BYTES,
+                          std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : _upstream(upstream)
+    {
+        addChunk(std::max<size_t>(initialBytes, 64));
+        reset();
+    }
+
+    MessageArena(const MessageArena&) = delete;
+    MessageArena& operator=(const MessageArena&) = delete;
+
+    ~MessageArena() override {
+        for (const Chunk& chunk : _chunks)
+            _upstream->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+    }
+
+    // Forgets every allocation, chunks are kept for the next message
+    void reset() {
+        _current = 0;
+        _next = _chunks[0].data;
+        _end = _next + _chunks[0].size;
+        _used = 0;
+    }
+
+    // Gives every chunk but the first back to upstream
+    void release() {
+        for (size_t i = 1; i < _chunks.size(); ++i)
+            _upstream->deallocate(_chunks[i].data, _chunks[i].size, alignof(std::max_align_t));
+        _chunks.resize(1);
+        reset();
+    }
+
+    // Bytes handed out since the last reset(), padding included
+    size_t used() const { return _used + static_cast<size_t>(_next - _chunks[_current].data); }
+    size_t capacity() const {
+        size_t total = 0;
+        for (const Chunk& chunk : _chunks)
+            total += chunk.size;
+        return total;
+    }
+    size_t chunkCount() const { return _chunks.size(); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        size_t padding = paddingFor(_next, alignment);
+        std::byte* ptr = UNLIKELY(padding + bytes > static_cast<size_t>(_end - _next))
+            ? nextChunk(bytes, alignment)
+            : _next + padding;
+        _next = ptr + bytes;
+        return ptr;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    static size_t paddingFor(const std::byte* ptr, size_t alignment) {
+        auto address = reinterpret_cast<uintptr_t>(ptr);
+        return (alignment - address % alignment) % alignment;
+    }
+
+    void addChunk(size_t size) {
+        auto* data = static_cast<std::byte*>(_upstream->allocate(size, alignof(std::max_align_t)));
+        _chunks.push_back(Chunk{data, size});
+    }
+
+    // First following chunk that can hold the request, a new one if none
+    std::byte* nextChunk(size_t bytes, size_t alignment) {
+        for (;;) {
+            _used += static_cast<size_t>(_next - _chunks[_current].data);
+            ++_current;
+            if (_current == _chunks.size())
+                addChunk(std::max(_chunks.back().size * 2, bytes + alignment));
+            Chunk& chunk = _chunks[_current];
+            _next = chunk.data;
+            _end = chunk.data + chunk.size;
+            size_t padding = paddingFor(_next, alignment);
+            if (padding + bytes <= chunk.size)
+                return _next + padding;
+        }
+    }
+};
@@ -1,6 +1,9 @@
 #pragma once
 #include "Macros.h"
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
 #include <cstddef>
 #include <stdexcept>
@@ -31,11 +34,49 @@ class StaticMemoryPool {
     static constexpr size_t CHUNK_SIZE = 64;
 
     static constexpr size_t NUM_CHUNKS = N / CHUNK_SIZE;
-    uint64_t bitmasks[NUM_CHUNKS] = {0};
-    int _freeIndex = 0;
+
+    /*
+    Free slots as a hierarchical bitmap, a set bit means free. Level 0 has one bit per
+    slot, every level above one bit per word of the level below, set while that word
+    has any bit set, up to a single top word. alloc() follows the lowest set bit down
+    from the top with __builtin_ctzll, alloc() and free() only touch the words on that
+    one path: 2 levels up to 4K slots, 3 up to 256K, 4 up to 16M.
+    */
+    static constexpr size_t LEVELS = [] {
+        size_t levels = 1;
+        for (size_t words = NUM_CHUNKS; words > 1; words = (words + CHUNK_SIZE - 1) / CHUNK_SIZE)
+            ++levels;
+        return levels;
+    }();
+
+    // _freeBits[LEVEL_OFFSET[level] + i] is word i of level
+    static constexpr std::array<size_t, LEVELS + 1> LEVEL_OFFSET = [] {
+        std::array<size_t, LEVELS + 1> offsets{};
+        size_t words = NUM_CHUNKS;
+        for (size_t level = 0; level < LEVELS; ++level) {
+            offsets[level + 1] = offsets[level] + words;
+            words = (words + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        }
+        return offsets;
+    }();
+
+    uint64_t _freeBits[LEVEL_OFFSET[LEVELS]];
+
+    bool isAllocated(size_t index) const {
+        return (_freeBits[index / CHUNK_SIZE] & (1ULL << (index % CHUNK_SIZE))) == 0;
+    }
 
 public:
-    StaticMemoryPool() = default;
+    StaticMemoryPool() {
+        // Every slot free, and above that a bit for every word that exists below
+        for (size_t level = 0; level < LEVELS; ++level) {
+            size_t children = level == 0 ? N : LEVEL_OFFSET[level] - LEVEL_OFFSET[level - 1];
+            for (size_t word = 0; word < LEVEL_OFFSET[level + 1] - LEVEL_OFFSET[level]; ++word) {
+                size_t bits = std::min(CHUNK_SIZE, children - word * CHUNK_SIZE);
+                _freeBits[LEVEL_OFFSET[level] + word] = bits == CHUNK_SIZE ? ~0ULL : (1ULL << bits) - 1;
+            }
+        }
+    }
     StaticMemoryPool(const StaticMemoryPool&) = delete;
     StaticMemoryPool& operator=(const StaticMemoryPool&) = delete;
     StaticMemoryPool(StaticMemoryPool&&) = delete;
@@ -44,9 +85,7 @@ public:
     ~StaticMemoryPool() {
         // Call destructors for all allocated objects
         for (size_t i = 0; i < N; ++i) {
-            int chunkIndex = i / CHUNK_SIZE;
-            int bitIndex = i % CHUNK_SIZE;
-            if (bitmasks[chunkIndex] & (1ULL << bitIndex)) {
+            if (isAllocated(i)) {
                 T* obj = reinterpret_cast<T*>(_buffer + i * sizeof(T));
                 obj->~T();
             }
@@ -56,28 +95,27 @@ public:
     template<typename... Args>
     T* alloc(Args&&... args) {
 
-        if (UNLIKELY(_freeIndex == -1)) {
+        if (UNLIKELY(_freeBits[LEVEL_OFFSET[LEVELS - 1]] == 0)) {
             throw std::runtime_error("StaticMemoryPool: No free memory available for allocation");
         }
 
-        void* place = _buffer + _freeIndex * sizeof(T);
+        // Lowest free slot: follow the lowest set bit from the top word down
+        size_t index = 0;
+        for (size_t level = LEVELS; level-- > 0;)
+            index = index * CHUNK_SIZE + __builtin_ctzll(_freeBits[LEVEL_OFFSET[level] + index]);
+
+        void* place = _buffer + index * sizeof(T);
         T* obj = new(place) T(std::forward<Args>(args)...);
 
-        // Mark the current slot as allocated
-        int chunkIndex = _freeIndex / CHUNK_SIZE;
-        int bitIndex = _freeIndex % CHUNK_SIZE;
-        bitmasks[chunkIndex] |= (1ULL << bitIndex);
-
-        _freeIndex = -1; // This indicates all slots are full now
-        // find next free index using __builtin_ffsl
-        for (size_t i = 0; i < NUM_CHUNKS; ++i) {
-            int bitPos = __builtin_ffsll(~bitmasks[i]);
-            if (bitPos != 0) {
-                _freeIndex = i * CHUNK_SIZE + (bitPos - 1);
+        // Mark the slot as allocated, clearing summary bits for as long as a word empties
+        for (size_t level = 0; level < LEVELS; ++level) {
+            uint64_t& word = _freeBits[LEVEL_OFFSET[level] + index / CHUNK_SIZE];
+            word &= ~(1ULL << (index % CHUNK_SIZE));
+            if (word != 0)
                 break;
-            }
+            index /= CHUNK_SIZE;
         }
-        
+
         return obj;
     }
 
@@ -94,14 +132,14 @@ public:
         // Call the destructor
         ptr->~T();
 
-        // Mark the slot as free
-        int chunkIndex = index / CHUNK_SIZE;
-        int bitIndex = index % CHUNK_SIZE;
-        bitmasks[chunkIndex] &= ~(1ULL << bitIndex);
-
-        // Update _freeIndex if necessary i.e. deallocated index was the lastest free index
-        if (UNLIKELY(_freeIndex == -1)) {
-            _freeIndex = index;
+        // Mark the slot as free, setting summary bits for as long as a word was empty
+        for (size_t level = 0; level < LEVELS; ++level) {
+            uint64_t& word = _freeBits[LEVEL_OFFSET[level] + index / CHUNK_SIZE];
+            bool wasEmpty = word == 0;
+            word |= 1ULL << (index % CHUNK_SIZE);
+            if (!wasEmpty)
+                break;
+            index /= CHUNK_SIZE;
         }
     }
 };
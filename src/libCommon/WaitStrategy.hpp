@@ -0,0 +1,175 @@
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include "Macros.h"
+
+/*
+How a consumer waits for a queue to have something, chosen per queue (see WaitingQueue).
+waitUntil(ready) returns once ready() returned true; ready() may have side effects,
+such as consuming the element, it is not called again after returning true.
+Producers call notify() after publishing, wakeAll() wakes any waiter unconditionally
+(shutdown).
+
+    BusySpin    burns the core, lowest latency, for a pinned thread on the order path
+    SpinYield   spins, then gives the core away between checks
+    Blocking    spins, yields, then sleeps on std::atomic::wait (a futex on Linux);
+                producers only pay for a notify while a consumer is asleep
+*/
+namespace WaitStrategy
+{
+    template<typename Wait>
+    concept Strategy = requires(Wait& wait, bool (*ready)()) {
+        wait.waitUntil(ready);
+        wait.notify();
+        wait.wakeAll();
+    };
+
+    struct BusySpin {
+        template<std::predicate Ready>
+        void waitUntil(Ready&& ready) {
+            while (!ready())
+                CPU_RELAX();
+        }
+        void notify() {}
+        void wakeAll() {}
+    };
+
+    template<uint32_t SpinRounds = 1000>
+    struct SpinYield {
+        template<std::predicate Ready>
+        void waitUntil(Ready&& ready) {
+            for (uint32_t round = 0; !ready(); ++round) {
+                if (round < SpinRounds)
+                    CPU_RELAX();
+                else
+                    std::this_thread::yield();
+            }
+        }
+        void notify() {}
+        void wakeAll() {}
+    };
+
+    template<uint32_t SpinRounds = 2000, uint32_t YieldRounds = 50>
+    class Blocking {
+        std::atomic<uint32_t> _epoch = 0;       // bumped to wake sleepers
+        std::atomic<uint32_t> _sleepers = 0;
+
+        template<typename Ready>
+        bool sleepUnlessReady(Ready& ready) {
+            uint32_t ticket = _epoch.load(std::memory_order_acquire);
+            _sleepers.fetch_add(1, std::memory_order_relaxed);
+            // Pairs with the fence in notify(): either the producer sees a sleeper, or
+            // this re-check sees its element
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool done = ready();
+            if (!done)
+                _epoch.wait(ticket, std::memory_order_acquire);
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            return done;
+        }
+
+    public:
+        template<std::predicate Ready>
+        void waitUntil(Ready&& ready) {
+            waitUntil(ready, [] {});
+        }
+
+        // Same, calling beforeSleep() each time the spin and yield rounds are over and
+        // the thread is about to sleep, e.g. to flush what it has buffered
+        template<std::predicate Ready, std::invocable BeforeSleep>
+        void waitUntil(Ready&& ready, BeforeSleep&& beforeSleep) {
+            uint32_t round = 0;
+            while (!ready()) {
+                ++round;
+                if (round <= SpinRounds) {
+                    CPU_RELAX();
+                } else if (round <= SpinRounds + YieldRounds) {
+                    std::this_thread::yield();
+                } else {
+                    beforeSleep();
+                    if (sleepUnlessReady(ready))
+                        return;
+                    round = 0;
+                }
+            }
+        }
+
+        // Call after publishing. A fence and a load when nobody sleeps.
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (UNLIKELY(_sleepers.load(std::memory_order_relaxed) != 0))
+                wakeAll();
+        }
+
+        void wakeAll() {
+            _epoch.fetch_add(1, std::memory_order_release);
+            _epoch.notify_all();
+        }
+    };
+}
+
+/*
+A queue plus the wait strategy of its consumers. Every producer call notifies after a
+successful push; consumers can block in consume_wait() instead of polling.
+
+    WaitingQueue<LockFreeQueue<Order, 1024>, WaitStrategy::BusySpin> orders;
+    WaitingQueue<LockFreeQueue<AdminMsg, 64, QueuePolicy::MPSC>, WaitStrategy::Blocking<>> admin;
+*/
+template<typename Queue, WaitStrategy::Strategy Wait>
+class WaitingQueue : public Queue {
+    Wait _wait;
+
+public:
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        if (!Queue::emplace(std::forward<Args>(args)...))
+            return false;
+        _wait.notify();
+        return true;
+    }
+
+    template<typename Item>
+    bool try_push(Item&& item) {
+        return emplace(std::forward<Item>(item));
+    }
+
+    template<typename Item>
+    auto enqueue(Item&& item) {
+        auto result = Queue::enqueue(std::forward<Item>(item));
+        if (result)
+            _wait.notify();
+        return result;
+    }
+
+    template<typename Items>
+    size_t enqueue_bulk(Items&& items) {
+        size_t count = Queue::enqueue_bulk(std::forward<Items>(items));
+        if (count != 0)
+            _wait.notify();
+        return count;
+    }
+
+    // Waits until an element is there, then consumes it like consume()
+    template<typename Fn>
+    void consume_wait(Fn&& fn) {
+        _wait.waitUntil([&] { return Queue::consume(fn); });
+    }
+
+    // Same, but gives up once stop is requested. false if nothing was consumed.
+    template<typename Fn>
+    bool consume_wait(Fn&& fn, const std::stop_token& stop) {
+        bool consumed = false;
+        _wait.waitUntil([&] {
+            consumed = Queue::consume(fn);
+            return consumed || stop.stop_requested();
+        });
+        return consumed;
+    }
+
+    // Wakes blocked consumers, e.g. after requesting a stop
+    void wakeAll() { _wait.wakeAll(); }
+};
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "FixDictionary.h"
+
+// Slots are resolved at compile time
+static_assert(Fix44::NewOrderSingle::slotOf<FixDict::BeginString>() == 0);
+static_assert(Fix44::NewOrderSingle::slotOf<FixDict::ClOrdID>() == 7);
+static_assert(Fix44::NewOrderSingle::msgType == "D");
+static_assert(Fix42::ExecutionReport::beginString == "FIX.4.2");
+static_assert(Fix42::ExecutionReport::FIELD_COUNT == Fix44::ExecutionReport::FIELD_COUNT + 1);
+
+namespace {
+    FixMessage makeNewOrderSingle() {
+        FixMessage msg;
+        msg.addField(8, "FIX.4.4");
+        msg.addField(9, "120");
+        msg.addField(35, "D");
+        msg.addField(49, "CLIENT");
+        msg.addField(56, "BROKER");
+        msg.addField(34, "17");
+        msg.addField(52, "20240102-09:30:00.000");
+        msg.addField(11, "ORD-1");
+        msg.addField(55, "IBM");
+        msg.addField(54, "1");
+        msg.addField(38, "250");
+        msg.addField(40, "2");
+        msg.addField(44, "187.25");
+        msg.addField(9001, "custom");   // not in the dictionary
+        msg.addField(10, "042");
+        return msg;
+    }
+}
+
+TEST(FixDictionaryTest, TypedAccessors) {
+    FixMessage msg = makeNewOrderSingle();
+    Fix44::NewOrderSingle order;
+    EXPECT_TRUE(order.bind(msg));
+
+    EXPECT_EQ(order.clOrdId(), "ORD-1");
+    EXPECT_EQ(order.symbol(), "IBM");
+    EXPECT_EQ(order.side(), '1');
+    EXPECT_EQ(order.ordType(), '2');
+    EXPECT_EQ(order.msgSeqNum(), 17u);
+    EXPECT_EQ(order.orderQty(), (FixDecimal{250, 0}));
+    EXPECT_EQ(order.price(), (FixDecimal{18725, -2}));
+    EXPECT_EQ(order.senderCompId(), "CLIENT");
+
+    // Optional fields that were not sent
+    EXPECT_FALSE(order.has<FixDict::Account>());
+    EXPECT_EQ(order.timeInForce(), std::nullopt);
+
+    // Tags outside the dictionary are still reachable
+    EXPECT_EQ(order.message().getFieldView(9001), "custom");
+}
+
+TEST(FixDictionaryTest, BindChecksMsgType) {
+    FixMessage msg = makeNewOrderSingle();
+    Fix44::ExecutionReport report;
+    EXPECT_FALSE(report.bind(msg));
+    EXPECT_EQ(report.clOrdId(), "ORD-1");
+
+    // Rebinding to another message resets every slot
+    FixMessage other;
+    other.addField(35, "8");
+    other.addField(37, "EX-1");
+    EXPECT_TRUE(report.bind(other));
+    EXPECT_EQ(report.orderId(), "EX-1");
+    EXPECT_EQ(report.clOrdId(), std::nullopt);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include "FixMessage.h"
+#include "FixExceptions.h"
+#include "FixTags.h"
+
+TEST(FixMessageTest, KeepsWireOrderAndRepeatedTags) {
+    FixMessage msg;
+    msg.addField(8, "FIX.4.4");
+    msg.addField(35, "W");
+    msg.addField(268, "2");
+    msg.addField(269, "0");
+    msg.addField(270, "101.5");
+    msg.addField(269, "1");
+    msg.addField(270, "101.75");
+    msg.addField(10, "123");
+
+    //1. Iteration follows the order fields were added
+    ASSERT_EQ(msg.fieldCount(), 8);
+    EXPECT_EQ(msg.field(0).tag, 8);
+    EXPECT_EQ(msg.field(5).tag, 269);
+    EXPECT_EQ(msg.field(5).value, "1");
+    EXPECT_EQ(msg.field(7).tag, 10);
+
+    //2. Lookups return the first occurrence of a repeated tag
+    EXPECT_EQ(msg.getFieldStr(270), "101.5");
+    EXPECT_EQ(msg.getFieldView(269), "0");
+
+    //3. Missing tags
+    std::string val;
+    EXPECT_FALSE(msg.tryGetFieldStr(44, val));
+    EXPECT_THROW(msg.getFieldStr(44), FixFieldNotFoundException);
+}
+
+TEST(FixMessageTest, OverflowAndHighTags) {
+    FixMessage msg;
+    // More fields than fit inline, half of them above the dense index limit
+    for (int i = 0; i < 200; ++i) {
+        int tag = (i % 2 == 0) ? i + 1 : FIX_DENSE_TAG_LIMIT + i;
+        msg.addField(tag, "value" + std::to_string(i));
+    }
+
+    ASSERT_EQ(msg.fieldCount(), 200);
+    for (int i = 0; i < 200; ++i) {
+        int tag = (i % 2 == 0) ? i + 1 : FIX_DENSE_TAG_LIMIT + i;
+        EXPECT_EQ(msg.getFieldView(tag), "value" + std::to_string(i));
+        EXPECT_EQ(msg.field(i).tag, tag);
+    }
+    EXPECT_FALSE(msg.getFieldView(FIX_DENSE_TAG_LIMIT + 1000).has_value());
+}
+
+TEST(FixMessageTest, ClearAndReuse) {
+    FixMessage msg;
+    for (int round = 0; round < 3; ++round) {
+        msg.clear();
+        EXPECT_EQ(msg.fieldCount(), 0);
+        EXPECT_FALSE(msg.getFieldView(11).has_value());
+
+        msg.addField(35, "D");
+        msg.addField(11, "ORDER" + std::to_string(round));
+        if (round == 0) {
+            // Only the first round sets tag 58, later rounds must not see it
+            msg.addField(58, "first round only");
+        }
+
+        EXPECT_EQ(msg.getFieldStr(11), "ORDER" + std::to_string(round));
+        EXPECT_EQ(msg.getFieldView(58).has_value(), round == 0);
+        EXPECT_EQ(msg.getField<int>(11), std::nullopt);
+    }
+}
+
+TEST(FixMessageTest, TypedFieldDecoding) {
+    FixMessage msg;
+    msg.addField(34, "4294967296");
+    msg.addField(38, "100");
+    msg.addField(44, "123.450");
+    msg.addField(54, "1");
+    msg.addField(58, "text with spaces");
+    msg.addField(43, "Y");
+    msg.addField(99, "-42");
+    msg.addField(100, "12x");
+    msg.addField(101, "");
+
+    //1. Integers
+    EXPECT_EQ(msg.getField<int64_t>(34), 4294967296LL);
+    EXPECT_EQ(msg.getField<int>(34), std::nullopt);       // overflow
+    EXPECT_EQ(msg.getField<int>(99), -42);
+    EXPECT_EQ(msg.getField<unsigned>(99), std::nullopt);
+    EXPECT_EQ(msg.getField<int>(100), std::nullopt);
+    EXPECT_EQ(msg.getField<int>(101), std::nullopt);
+
+    //2. Chars, booleans and strings
+    EXPECT_EQ(msg.getField<char>(54), '1');
+    EXPECT_EQ(msg.getField<bool>(43), true);
+    EXPECT_EQ(msg.getField<std::string>(58), "text with spaces");
+    EXPECT_EQ(msg.getField<std::string_view>(58), "text with spaces");
+
+    //3. Prices never go through double
+    EXPECT_TRUE(FixTag::isDecimalTag(FixTag::Price));
+    EXPECT_FALSE(FixTag::isDecimalTag(FixTag::MsgSeqNum));
+    auto price = msg.getField<FixDecimal>(FixTag::Price);
+    ASSERT_TRUE(price.has_value());
+    EXPECT_EQ(price->mantissa, 123450);
+    EXPECT_EQ(price->exponent, -3);
+    EXPECT_EQ(*price, (FixDecimal{12345, -2}));
+    EXPECT_LT(*price, (FixDecimal{1235, -1}));
+    EXPECT_DOUBLE_EQ(price->toDouble(), 123.45);
+    EXPECT_DOUBLE_EQ(*msg.getField<double>(44), 123.45);
+}
+
+TEST(FixMessageTest, DecimalAndIntegerEdgeCases) {
+    FixDecimal d;
+    EXPECT_TRUE(FixDecimal::parse("-0.0001", d));
+    EXPECT_EQ(d, (FixDecimal{-1, -4}));
+    EXPECT_TRUE(FixDecimal::parse("100.", d));
+    EXPECT_EQ(d, (FixDecimal{100, 0}));
+    EXPECT_FALSE(FixDecimal::parse("", d));
+    EXPECT_FALSE(FixDecimal::parse(".", d));
+    EXPECT_FALSE(FixDecimal::parse("1.2.3", d));
+    EXPECT_FALSE(FixDecimal::parse("1e5", d));
+    EXPECT_FALSE(FixDecimal::parse("1234567890123456789", d));
+
+    // Exponent gaps past what 128 bit scaling can hold, decided by sign and exponent
+    EXPECT_GT((FixDecimal{1, 100}), (FixDecimal{INT64_MAX, -100}));
+    EXPECT_LT((FixDecimal{-1, 100}), (FixDecimal{-INT64_MAX, -100}));
+    EXPECT_LT((FixDecimal{INT64_MIN, 100}), (FixDecimal{1, -100}));
+    EXPECT_EQ((FixDecimal{0, 100}), (FixDecimal{0, -100}));
+    EXPECT_LT((FixDecimal{0, 100}), (FixDecimal{1, -100}));
+    EXPECT_GT((FixDecimal{INT64_MAX, -19}), (FixDecimal{9, -1}));
+    EXPECT_LT((FixDecimal{INT64_MAX, -19}), (FixDecimal{1, 0}));
+    EXPECT_LT((FixDecimal{INT64_MIN, 19}), (FixDecimal{INT64_MIN, 0}));
+
+    int8_t small = 0;
+    EXPECT_TRUE(decodeFixInteger(std::string_view("-128"), small));
+    EXPECT_EQ(small, -128);
+    EXPECT_FALSE(decodeFixInteger(std::string_view("128"), small));
+    EXPECT_FALSE(decodeFixInteger(std::string_view("-"), small));
+}
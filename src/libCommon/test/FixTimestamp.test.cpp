@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <format>
+#include <string>
+#include "FixTimestamp.h"
+
+namespace {
+    uint64_t epochNs(int year, unsigned month, unsigned day, int hour, int minute, int second, uint64_t ns) {
+        using namespace std::chrono;
+        sys_days date = year_month_day{std::chrono::year(year), std::chrono::month(month), std::chrono::day(day)};
+        auto time = date + hours(hour) + minutes(minute) + seconds(second);
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(time.time_since_epoch()).count()) + ns;
+    }
+}
+
+TEST(FixTimestampTest, FormatsEachPrecision) {
+    uint64_t ns = epochNs(2024, 1, 2, 9, 30, 5, 123456789);
+
+    //1. Fraction is truncated to the precision, never rounded
+    EXPECT_EQ(FixTimestampFormatter(FixTimePrecision::Seconds).format(ns), "20240102-09:30:05");
+    EXPECT_EQ(FixTimestampFormatter(FixTimePrecision::Millis).format(ns), "20240102-09:30:05.123");
+    EXPECT_EQ(FixTimestampFormatter(FixTimePrecision::Micros).format(ns), "20240102-09:30:05.123456");
+    EXPECT_EQ(FixTimestampFormatter(FixTimePrecision::Nanos).format(ns), "20240102-09:30:05.123456789");
+
+    //2. Leading zeros in the fraction
+    EXPECT_EQ(FixTimestampFormatter(FixTimePrecision::Micros).format(epochNs(2024, 1, 2, 9, 30, 5, 7000)),
+              "20240102-09:30:05.000007");
+
+    //3. length() matches what is written
+    for (auto precision : {FixTimePrecision::Seconds, FixTimePrecision::Millis, FixTimePrecision::Micros, FixTimePrecision::Nanos}) {
+        FixTimestampFormatter clock(precision);
+        EXPECT_EQ(clock.format(ns).size(), clock.length());
+    }
+}
+
+TEST(FixTimestampTest, CachedPrefixFollowsSecondChanges) {
+    FixTimestampFormatter clock(FixTimePrecision::Millis);
+
+    //1. Same second, only the fraction changes
+    EXPECT_EQ(clock.format(epochNs(2024, 2, 29, 23, 59, 59, 1000000)), "20240229-23:59:59.001");
+    EXPECT_EQ(clock.format(epochNs(2024, 2, 29, 23, 59, 59, 999000000)), "20240229-23:59:59.999");
+
+    //2. Crossing midnight into March of a leap year, and going back in time
+    EXPECT_EQ(clock.format(epochNs(2024, 3, 1, 0, 0, 0, 0)), "20240301-00:00:00.000");
+    EXPECT_EQ(clock.format(epochNs(1999, 12, 31, 12, 0, 0, 500000000)), "19991231-12:00:00.500");
+}
+
+TEST(FixTimestampTest, AgreesWithChronoOverManyDays) {
+    // Walk ~150 years in steps that hit every month and time of day
+    FixTimestampFormatter clock(FixTimePrecision::Seconds);
+    using namespace std::chrono;
+    for (int64_t second = 0; second < 4'700'000'000; second += 86400 * 7 + 3607) {
+        std::string expected = std::format("{:%Y%m%d-%H:%M:%S}", sys_seconds(seconds(second)));
+        ASSERT_EQ(clock.format(static_cast<uint64_t>(second) * 1'000'000'000ull), expected);
+    }
+}
+
+TEST(FixTimestampTest, ClockIsWallTime) {
+    using namespace std::chrono;
+    uint64_t before = static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+    uint64_t now = FixClock::nowNs();
+    uint64_t after = static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+    EXPECT_LE(before, now);
+    EXPECT_LE(now, after);
+}
@@ -1,6 +1,13 @@
 #include <benchmark/benchmark.h>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
 #include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
 #include "LockFreeQueue.hpp"
+#include "WaitStrategy.hpp"
 
 namespace {
     class ComplexStruct {
@@ -37,22 +44,34 @@ static void BM_EnqueueDequeue(benchmark::State& state) {
     for (auto _ : state) {
         if (state.thread_index() == 0) {
             // Producer
-            benchmark::DoNotOptimize(q.enqueue(ComplexStruct(local_i++)));
+            benchmark::DoNotOptimize(q.emplace(local_i++));
         } else {
             // Consumer
-            ComplexStruct item;
-            benchmark::DoNotOptimize(q.dequeue(item));
+            benchmark::DoNotOptimize(q.consume([](ComplexStruct& item) { benchmark::DoNotOptimize(item); }));
         }
     }
 }
 BENCHMARK(BM_EnqueueDequeue)->Threads(2)->UseRealTime();
 
+// SPSC: thread 1 consumes. MPSC: thread 0 consumes, every other thread produces.
+// MPMC: odd threads consume. Only delivered elements count, so items_per_second is the
+// queue's throughput whatever the thread count.
+template<typename Policy>
+static bool isConsumer(int threadIndex) {
+    if constexpr (std::same_as<Policy, QueuePolicy::MPSC>)
+        return threadIndex == 0;
+    else
+        return threadIndex % 2 == 1;
+}
+
+template<typename Policy>
 static void BM_LockFreeQueue_ProdCons(benchmark::State& state) {
-    static LockFreeQueue<ComplexStruct, 262144> q;      // shared across threads
+    static LockFreeQueue<ComplexStruct, 262144, Policy> q;      // shared across threads
     static std::atomic<bool> start{false};
 
     int value = 0;
-    size_t ops = 0;
+    size_t delivered = 0;
+    const bool consumer = isConsumer<Policy>(state.thread_index());
 
     // synchronize start
     if (state.thread_index() == 0) {
@@ -62,24 +81,152 @@ static void BM_LockFreeQueue_ProdCons(benchmark::State& state) {
     }
 
     for (auto _ : state) {
-        int thread_idx = state.thread_index();
-        if (thread_idx % 2 == 0) {
+        if (!consumer) {
             // Producer
-            if (q.enqueue(value)) {
+            if (q.emplace(value))
                 ++value;
-                ++ops;
-            }
         } else {
             // Consumer
-            ComplexStruct cs;
-            if (q.dequeue(cs)) {
-                ++ops;
-            }
+            if (q.consume([](ComplexStruct& cs) { benchmark::DoNotOptimize(cs); }))
+                ++delivered;
+        }
+    }
+
+    state.SetItemsProcessed(delivered);
+}
+// One producer and one consumer is all the SPSC queue supports
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_ProdCons, QueuePolicy::SPSC)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_ProdCons, QueuePolicy::MPSC)->Threads(2)->Threads(4)->Threads(8)->Threads(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockFreeQueue_ProdCons, QueuePolicy::MPMC)->Threads(2)->Threads(4)->Threads(8)->Threads(16)->UseRealTime();
+
+namespace {
+    // Same size as a logger record, trivially copyable
+    struct LargeRecord {
+        uint64_t sequence;
+        char payload[504];
+    };
+}
+
+// Large element copied out into a local, as dequeue() does
+static void BM_LargeRecord_Dequeue(benchmark::State& state) {
+    static LockFreeQueue<LargeRecord, 1024> q;
+    uint64_t sequence = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            LargeRecord record;
+            record.sequence = sequence++;
+            benchmark::DoNotOptimize(q.try_push(record));
+        } else {
+            LargeRecord record;
+            benchmark::DoNotOptimize(q.dequeue(record));
+            benchmark::DoNotOptimize(record.sequence);
+        }
+    }
+}
+BENCHMARK(BM_LargeRecord_Dequeue)->Threads(2)->UseRealTime();
+
+// Large element read where it lies, as consume() does
+static void BM_LargeRecord_Consume(benchmark::State& state) {
+    static LockFreeQueue<LargeRecord, 1024> q;
+    uint64_t sequence = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            LargeRecord record;
+            record.sequence = sequence++;
+            benchmark::DoNotOptimize(q.try_push(record));
+        } else {
+            benchmark::DoNotOptimize(q.consume([](LargeRecord& record) { benchmark::DoNotOptimize(record.sequence); }));
+        }
+    }
+}
+BENCHMARK(BM_LargeRecord_Consume)->Threads(2)->UseRealTime();
+
+namespace {
+    // A parsed message handed from the parser thread to a strategy thread
+    struct Handoff {
+        uint64_t sequence;
+        uint64_t payload[7];
+    };
+}
+
+// Producer publishes state.range(0) elements per enqueue_bulk, the consumer takes
+// whatever is there with read_available. Batch size 1 is the per-element cost.
+// Only the consumer counts, so items_per_second is delivered elements for every batch size.
+static void BM_Bulk_ProdCons(benchmark::State& state) {
+    static LockFreeQueue<Handoff, 4096> q;
+    const size_t batch = static_cast<size_t>(state.range(0));
+    std::vector<Handoff> items(batch);
+    uint64_t sequence = 0;
+    size_t delivered = 0;
+
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            for (auto& item : items)
+                item.sequence = sequence++;
+            benchmark::DoNotOptimize(q.enqueue_bulk(items));
+        } else {
+            delivered += q.read_available([](std::span<Handoff> run) {
+                for (auto& item : run)
+                    benchmark::DoNotOptimize(item.sequence);
+            }, batch);
+        }
+    }
+    state.SetItemsProcessed(state.thread_index() == 0 ? 0 : delivered);
+}
+BENCHMARK(BM_Bulk_ProdCons)->Arg(1)->Arg(8)->Arg(64)->Arg(512)->Threads(2)->UseRealTime();
+
+// Same traffic through dequeue_bulk, which copies out
+static void BM_Bulk_DequeueBulk(benchmark::State& state) {
+    static LockFreeQueue<Handoff, 4096> q;
+    const size_t batch = static_cast<size_t>(state.range(0));
+    std::vector<Handoff> items(batch);
+    uint64_t sequence = 0;
+    size_t delivered = 0;
+
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            for (auto& item : items)
+                item.sequence = sequence++;
+            benchmark::DoNotOptimize(q.enqueue_bulk(items));
+        } else {
+            delivered += q.dequeue_bulk(items);
+            benchmark::DoNotOptimize(items.data());
         }
     }
+    state.SetItemsProcessed(state.thread_index() == 0 ? 0 : delivered);
+}
+BENCHMARK(BM_Bulk_DequeueBulk)->Arg(1)->Arg(8)->Arg(64)->Arg(512)->Threads(2)->UseRealTime();
+
+// Round trip through two queues to an echo thread. With Blocking the echo thread sleeps
+// between pings once state.range(0) microseconds of idle time exceed its spin budget.
+template<typename Wait>
+static void BM_WaitStrategy_PingPong(benchmark::State& state) {
+    WaitingQueue<LockFreeQueue<uint64_t, 64>, Wait> ping;
+    WaitingQueue<LockFreeQueue<uint64_t, 64>, Wait> pong;
+    const auto idle = std::chrono::microseconds(state.range(0));
+
+    std::jthread echo([&](std::stop_token st) {
+        uint64_t value = 0;
+        while (ping.consume_wait([&](uint64_t v) { value = v; }, st))
+            pong.emplace(value);
+    });
+
+    uint64_t sequence = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (idle.count() > 0)
+            std::this_thread::sleep_for(idle);
+        state.ResumeTiming();
+
+        ping.emplace(sequence++);
+        pong.consume_wait([](uint64_t v) { benchmark::DoNotOptimize(v); });
+    }
 
-    state.SetItemsProcessed(ops);
+    echo.request_stop();
+    ping.wakeAll();
 }
-BENCHMARK(BM_LockFreeQueue_ProdCons)->Threads(2)->Threads(4)->Threads(8)->Threads(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WaitStrategy_PingPong, WaitStrategy::BusySpin)->Arg(0)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WaitStrategy_PingPong, WaitStrategy::SpinYield<>)->Arg(0)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WaitStrategy_PingPong, WaitStrategy::Blocking<>)->Arg(0)->Arg(100)->UseRealTime();
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -1,9 +1,17 @@
 #include <gtest/gtest.h>
 #include "LockFreeQueue.hpp"
+#include "WaitStrategy.hpp"
 #include <iostream>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <string>
+#include <array>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
 
 namespace {
     class ComplexStruct {
@@ -30,20 +38,21 @@ namespace {
 } 
 
 TEST(LockFreeQueueTest, BasicEnqueueDequeue) {
-    LockFreeQueue<ComplexStruct, 4> queue;
+    LockFreeQueue<std::string, 4> queue;
 
     //1. Enqueue elements into the queue
     // Enqueue up to capacity - 1. Due to the design, one slot is left empty to distinguish full vs empty.
     {
         for (int i = 1; i <= 3; ++i) {
-            auto result = queue.enqueue(ComplexStruct(i));
+            // Long enough to live on the heap, a bytewise copy would double free it
+            auto result = queue.enqueue(std::string(32, static_cast<char>('0' + i)));
             EXPECT_TRUE(result.has_value());
         }
     }
 
     //2. Attempt to enqueue into a full queue
     {
-        auto result = queue.enqueue(ComplexStruct(4));
+        auto result = queue.enqueue(std::string("4"));
         EXPECT_FALSE(result.has_value());
         EXPECT_EQ(result.error(), "LockFreeQueue: Queue is full");
     }
@@ -51,42 +60,159 @@ TEST(LockFreeQueueTest, BasicEnqueueDequeue) {
     //3. Dequeue elements and verify order
     {
         for (int i = 1; i <= 3; ++i) {
-            ComplexStruct value(0);
+            std::string value;
             auto result = queue.dequeue(value);
             EXPECT_TRUE(result.has_value());
-            EXPECT_EQ(value.getId(), i);
+            EXPECT_EQ(value, std::string(32, static_cast<char>('0' + i)));
         }
     }
 
     //4. Queue should be empty now
     {
-        ComplexStruct value(0);
+        std::string value;
         auto result = queue.dequeue(value);
         EXPECT_FALSE(result.has_value());
         EXPECT_EQ(result.error(), "LockFreeQueue: Queue is empty");
     }
 }
 
+TEST(LockFreeQueueTest, EmplaceAndConsumeInPlace) {
+    // ComplexStruct can neither be copied nor moved, it only ever lives in its slot
+    LockFreeQueue<ComplexStruct, 4> queue;
+
+    //1. Constructed from the arguments, up to capacity - 1
+    for (int i = 1; i <= 3; ++i)
+        EXPECT_TRUE(queue.emplace(i));
+    EXPECT_FALSE(queue.emplace(4));
+
+    //2. Consumed in order, nothing to consume afterwards
+    for (int i = 1; i <= 3; ++i) {
+        int id = 0;
+        EXPECT_TRUE(queue.consume([&](ComplexStruct& value) { id = value.getId(); }));
+        EXPECT_EQ(id, i);
+    }
+    bool called = false;
+    EXPECT_FALSE(queue.consume([&](ComplexStruct&) { called = true; }));
+    EXPECT_FALSE(called);
+}
+
+namespace {
+    struct Counted {
+        static inline int alive = 0;
+        Counted() { ++alive; }
+        ~Counted() { --alive; }
+        Counted(const Counted&) = delete;
+        Counted& operator=(const Counted&) = delete;
+    };
+}
+
+TEST(LockFreeQueueTest, DestroysEveryElementOnce) {
+    {
+        LockFreeQueue<Counted, 8> queue;
+        //1. Nothing is constructed up front
+        EXPECT_EQ(Counted::alive, 0);
+
+        for (int i = 0; i < 5; ++i)
+            queue.emplace();
+        EXPECT_EQ(Counted::alive, 5);
+
+        //2. consume() and pop() destroy what they remove
+        queue.consume([](Counted&) {});
+        queue.pop();
+        EXPECT_EQ(Counted::alive, 3);
+    }
+    //3. The queue destroys what is left
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(LockFreeQueueTest, PeekLeavesElementQueued) {
+    LockFreeQueue<int, 4> queue;
+
+    //1. Nothing to peek at in an empty queue
+    EXPECT_EQ(queue.peek(), nullptr);
+    EXPECT_TRUE(queue.empty());
+
+    //2. peek() keeps returning the oldest element until pop()
+    queue.enqueue(1);
+    queue.enqueue(2);
+    ASSERT_NE(queue.peek(), nullptr);
+    EXPECT_EQ(*queue.peek(), 1);
+    EXPECT_EQ(*queue.peek(), 1);
+    queue.pop();
+    EXPECT_EQ(*queue.peek(), 2);
+    queue.pop();
+    EXPECT_EQ(queue.peek(), nullptr);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, BulkOperationsWrapAround) {
+    LockFreeQueue<int, 8> queue;
+    std::vector<int> items = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    //1. Only 7 fit
+    EXPECT_EQ(queue.enqueue_bulk(items), 7u);
+
+    //2. Bounded by max, then by the output size
+    std::array<int, 8> out{};
+    EXPECT_EQ(queue.dequeue_bulk(out, 5), 5u);
+    EXPECT_EQ(out[4], 4);
+
+    //3. The ring wraps: slots 7, 0, 1, 2 are written now
+    EXPECT_EQ(queue.enqueue_bulk(std::span<const int>(items).subspan(7)), 3u);
+
+    //4. Two contiguous runs, in order, both gone afterwards
+    std::vector<size_t> runs;
+    std::vector<int> read;
+    EXPECT_EQ(queue.read_available([&](std::span<int> run) {
+        runs.push_back(run.size());
+        read.insert(read.end(), run.begin(), run.end());
+    }), 5u);
+    EXPECT_EQ(runs, (std::vector<size_t>{3, 2}));
+    EXPECT_EQ(read, (std::vector<int>{5, 6, 7, 8, 9}));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.read_available([](std::span<int>) { FAIL(); }), 0u);
+}
+
+TEST(LockFreeQueueTest, BulkOperationsOnNonTrivialElements) {
+    LockFreeQueue<std::string, 16> queue;
+    std::vector<std::string> items;
+    for (int i = 0; i < 10; ++i)
+        items.push_back(std::string(32, static_cast<char>('a' + i)));
+
+    //1. Copied in, the source is left untouched
+    EXPECT_EQ(queue.enqueue_bulk(items), 10u);
+    EXPECT_EQ(items[9], std::string(32, 'j'));
+
+    //2. Moved out in two calls
+    std::array<std::string, 6> out;
+    EXPECT_EQ(queue.dequeue_bulk(out), 6u);
+    EXPECT_EQ(out[5], std::string(32, 'f'));
+    EXPECT_EQ(queue.dequeue_bulk(out), 4u);
+    EXPECT_EQ(out[3], std::string(32, 'j'));
+    EXPECT_TRUE(queue.empty());
+}
 
 TEST(LockFreeQueueTest, StressRaceTest) {
     LockFreeQueue<ComplexStruct, 1024> q;
 
     std::atomic<bool> start{false};
     std::atomic<bool> stop{false};
+    bool inOrder = true;
 
     std::thread producer([&] {
         while (!start.load(std::memory_order_relaxed));
         int x = 0;
         while (!stop.load(std::memory_order_relaxed)) {
-            q.enqueue(ComplexStruct(x++));
+            if (q.emplace(x))
+                ++x;
         }
     });
 
     std::thread consumer([&] {
         while (!start.load(std::memory_order_relaxed));
+        int expected = 0;
         while (!stop.load(std::memory_order_relaxed)) {
-            ComplexStruct x(0);
-            q.dequeue(x);
+            q.consume([&](ComplexStruct& x) { inOrder &= x.getId() == expected++; });
         }
     });
 
@@ -96,4 +222,153 @@ TEST(LockFreeQueueTest, StressRaceTest) {
 
     producer.join();
     consumer.join();
-}
\ No newline at end of file
+    EXPECT_TRUE(inOrder);
+}
+
+TEST(LockFreeQueueTest, MultiProducerQueuesUseEverySlot) {
+    LockFreeQueue<ComplexStruct, 4, QueuePolicy::MPMC> queue;
+
+    //1. Unlike the SPSC ring, all N slots hold an element
+    for (int i = 1; i <= 4; ++i)
+        EXPECT_TRUE(queue.emplace(i));
+    EXPECT_FALSE(queue.emplace(5));
+
+    //2. FIFO across laps of the ring
+    for (int i = 1; i <= 10; ++i) {
+        int id = 0;
+        EXPECT_TRUE(queue.consume([&](ComplexStruct& value) { id = value.getId(); }));
+        EXPECT_EQ(id, i);
+        EXPECT_TRUE(queue.emplace(i + 4));
+    }
+    EXPECT_FALSE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, MpscFanInKeepsPerProducerOrder) {
+    const int PRODUCERS = 4;
+    const int MESSAGES = 20000;
+    LockFreeQueue<std::pair<int, int>, 256, QueuePolicy::MPSC> queue;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < MESSAGES;) {
+                if (queue.emplace(p, i))
+                    ++i;
+            }
+        });
+    }
+
+    //1. One consumer sees everything, each producer's messages in the order sent
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    bool inOrder = true;
+    while (received < PRODUCERS * MESSAGES) {
+        queue.consume([&](std::pair<int, int>& msg) {
+            inOrder &= msg.second == next[msg.first]++;
+            ++received;
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, MpmcDeliversEachElementOnce) {
+    const int THREADS = 4;
+    const int MESSAGES = 20000;
+    LockFreeQueue<int, 128, QueuePolicy::MPMC> queue;
+    std::atomic<int> received{0};
+    std::vector<std::vector<int>> seen(THREADS);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < MESSAGES;) {
+                if (queue.emplace(t * MESSAGES + i))
+                    ++i;
+            }
+        });
+        threads.emplace_back([&, t] {
+            while (received.load(std::memory_order_relaxed) < THREADS * MESSAGES) {
+                if (queue.consume([&](int value) { seen[t].push_back(value); }))
+                    received.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    //1. Every value exactly once over all consumers
+    std::vector<int> all;
+    for (auto& values : seen)
+        all.insert(all.end(), values.begin(), values.end());
+    std::sort(all.begin(), all.end());
+    std::vector<int> expected(THREADS * MESSAGES);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(all, expected);
+}
+
+namespace {
+    // Producer sends 1..MESSAGES with pauses, the consumer waits for every one of them
+    template<typename Wait>
+    void handOffThroughWaitingQueue() {
+        const int MESSAGES = 200;
+        WaitingQueue<LockFreeQueue<int, 16>, Wait> queue;
+
+        std::thread producer([&] {
+            for (int i = 1; i <= MESSAGES; ++i) {
+                while (!queue.emplace(i))
+                    ;
+                if (i % 50 == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        });
+
+        int expected = 1;
+        for (int i = 1; i <= MESSAGES; ++i)
+            queue.consume_wait([&](int value) { EXPECT_EQ(value, expected++); });
+        producer.join();
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(WaitStrategyTest, EveryStrategyHandsOffInOrder) {
+    handOffThroughWaitingQueue<WaitStrategy::BusySpin>();
+    handOffThroughWaitingQueue<WaitStrategy::SpinYield<>>();
+    // Few rounds so the consumer is asleep during the producer's pauses
+    handOffThroughWaitingQueue<WaitStrategy::Blocking<10, 1>>();
+}
+
+TEST(WaitStrategyTest, BlockedConsumerStopsOnRequest) {
+    WaitingQueue<LockFreeQueue<int, 16, QueuePolicy::MPSC>, WaitStrategy::Blocking<10, 1>> queue;
+    std::stop_source stop;
+    std::atomic<bool> returned{false};
+    bool consumed = true;
+
+    //1. Nothing is ever pushed, only the stop request ends the wait
+    std::thread consumer([&] {
+        consumed = queue.consume_wait([](int) {}, stop.get_token());
+        returned.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned.load());
+
+    stop.request_stop();
+    queue.wakeAll();
+    consumer.join();
+    EXPECT_FALSE(consumed);
+}
+
+TEST(WaitStrategyTest, BlockingCallsBeforeSleepOnceSpinningIsOver) {
+    WaitStrategy::Blocking<4, 2> wait;
+    int checks = 0;
+    bool flushed = false;
+
+    // Ready only once the hook ran: 1 first check, 4 spins, 2 yields, then the hook and
+    // the re-check before sleeping, which succeeds
+    wait.waitUntil([&] { ++checks; return flushed; }, [&] { flushed = true; });
+    EXPECT_TRUE(flushed);
+    EXPECT_EQ(checks, 1 + 4 + 2 + 1);
+}
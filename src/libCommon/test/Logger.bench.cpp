@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "Logger.h"
+
+/*
+Cost of a LOG_* call on the calling thread. The writer drains in the background; every
+256 calls the timer is paused until it has caught up, so the queue never fills and no
+record is dropped while timing.
+*/
+
+namespace {
+    const int CALLS_PER_ROUND = 256;
+
+    void letWriterCatchUp(benchmark::State& state) {
+        state.PauseTiming();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        state.ResumeTiming();
+    }
+}
+
+static void BM_LogFilteredOut(benchmark::State& state) {
+    Logger::getInstance().setLogLevel(LogLevel::WARN);
+    int qty = 100;
+    for (auto _ : state) {
+        LOG_INFO("order {} qty {}", "ORD-1", qty);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFilteredOut);
+
+static void BM_LogInfoThreeArgs(benchmark::State& state) {
+    Logger::getInstance().setLogLevel(LogLevel::INFO);
+    std::string_view clOrdId = "ORD-0000012345";
+    int qty = 100;
+    double px = 412.75;
+    for (auto _ : state) {
+        for (int i = 0; i < CALLS_PER_ROUND; ++i)
+            LOG_INFO("order {} filled {} @ {}", clOrdId, qty, px);
+        letWriterCatchUp(state);
+    }
+    state.SetItemsProcessed(state.iterations() * CALLS_PER_ROUND);
+}
+BENCHMARK(BM_LogInfoThreeArgs);
+
+// A whole inbound NewOrderSingle copied into the record
+static void BM_LogInfoFixMessage(benchmark::State& state) {
+    Logger::getInstance().setLogLevel(LogLevel::INFO);
+    std::string_view fix = "8=FIX.4.4\x01" "9=148\x01" "35=D\x01" "49=CLIENT_COMP\x01" "56=BROKER_COMP\x01" "34=1024\x01"
+                           "52=20240102-09:30:00.123456\x01" "11=ORD-0000012345\x01" "1=ACCOUNT-7\x01" "21=1\x01"
+                           "55=MSFT\x01" "54=1\x01" "60=20240102-09:30:00.123456\x01" "38=500\x01" "40=2\x01"
+                           "44=412.75\x01" "59=0\x01" "10=123\x01";
+    for (auto _ : state) {
+        for (int i = 0; i < CALLS_PER_ROUND; ++i)
+            LOG_INFO("inbound {}", fix);
+        letWriterCatchUp(state);
+    }
+    state.SetItemsProcessed(state.iterations() * CALLS_PER_ROUND);
+}
+BENCHMARK(BM_LogInfoFixMessage);
+
+BENCHMARK_MAIN();
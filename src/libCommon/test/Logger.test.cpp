@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <vector>
+#include <zlib.h>
 #include "Logger.h"
 
 namespace fs = std::filesystem;
@@ -73,3 +79,220 @@ TEST(LoggerTest, LogFileGeneratedAndContent)
     }
 }
 
+
+TEST(LoggerTest, ArgumentsRoundTripThroughRecordBytes)
+{
+    //1. Every supported kind of argument comes back as formatted by std::format
+    char args[LOG_RECORD_ARGS_SIZE];
+    std::string clOrdId = "ORD-42";
+    const char* side = "BUY";
+    int qty = 100;
+    double px = 10.5;
+    LogArgs::encodeAll<std::string, const char*, int, double, char, bool>(args, sizeof(args), clOrdId, side, qty, px, 'X', true);
+
+    std::string out;
+    LogArgs::render<std::string, const char*, int, double, char, bool>(out, "{} {} {} {:.2f} {} {}", args);
+    EXPECT_EQ(out, "ORD-42 BUY 100 10.50 X true");
+
+    //2. A string too long for the record is cut, the arguments after it survive
+    std::string big(2 * LOG_RECORD_ARGS_SIZE, 'x');
+    size_t used = LogArgs::encodeAll<std::string, int>(args, sizeof(args), big, qty);
+    EXPECT_EQ(used, sizeof(args));
+    out.clear();
+    LogArgs::render<std::string, int>(out, "{}|{}", args);
+    EXPECT_EQ(out, std::string(LOG_RECORD_ARGS_SIZE - 2 * sizeof(uint32_t), 'x') + "|100");
+}
+
+TEST(LoggerTest, FormatsArgumentsOnWriterThread)
+{
+    Logger::getInstance().setLogLevel(LogLevel::INFO);
+    std::string clOrdId = "ORD-42";
+    std::string_view fix = "8=FIX.4.4|35=D|11=ORD-42|";
+    LOG_INFO("BINLOG order {} qty {} px {:.2f} fix {}", clOrdId, 100, 10.5, fix);
+    LOG_DEBUG("BINLOG filtered {}", 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::ifstream logFile(Logger::getInstance().getLogFileName());
+    ASSERT_TRUE(logFile.is_open());
+    std::string line;
+    int found = 0;
+    while (std::getline(logFile, line)) {
+        if (line.find("BINLOG") == std::string::npos)
+            continue;
+        ++found;
+        EXPECT_NE(line.find("[INFO]"), std::string::npos);
+        EXPECT_NE(line.find("BINLOG order ORD-42 qty 100 px 10.50 fix 8=FIX.4.4|35=D|11=ORD-42| (Logger.test.cpp:"), std::string::npos);
+    }
+    EXPECT_EQ(found, 1);
+}
+
+TEST(LoggerTest, ThreadsLogConcurrently)
+{
+    Logger::getInstance().setLogLevel(LogLevel::INFO);
+    const int THREADS = 8;
+    const int MESSAGES = 200;
+
+    //1. 8 threads, each with its own queue; every line must arrive exactly once
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < MESSAGES; ++i)
+                LOG_INFO("MTLOG thread {} seq {}", t, i);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    //2. Nothing lost, and every thread's records are in the order it logged them
+    std::ifstream logFile(Logger::getInstance().getLogFileName());
+    ASSERT_TRUE(logFile.is_open());
+    std::vector<int> nextSeq(THREADS, 0);
+    std::string line;
+    while (std::getline(logFile, line)) {
+        size_t pos = line.find("MTLOG thread ");
+        if (pos == std::string::npos)
+            continue;
+        int thread = 0, seq = 0;
+        ASSERT_EQ(std::sscanf(line.c_str() + pos, "MTLOG thread %d seq %d", &thread, &seq), 2);
+        EXPECT_EQ(seq, nextSeq[thread]);
+        nextSeq[thread] = seq + 1;
+    }
+    for (int t = 0; t < THREADS; ++t)
+        EXPECT_EQ(nextSeq[t], MESSAGES);
+}
+
+namespace {
+    // Polls the log file until a line containing needle shows up or the timeout expires
+    bool waitForLine(const std::string& needle, std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        do {
+            std::ifstream logFile(Logger::getInstance().getLogFileName());
+            std::string line;
+            while (std::getline(logFile, line)) {
+                if (line.find(needle) != std::string::npos)
+                    return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } while (std::chrono::steady_clock::now() < deadline);
+        return false;
+    }
+}
+
+TEST(LoggerTest, ParkedWriterWakesUpForNewRecords)
+{
+    Logger::getInstance().setLogLevel(LogLevel::INFO);
+
+    //1. Long enough for the writer to be past spinning and yielding, and parked
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    LOG_INFO("WAKELOG {}", 1);
+    EXPECT_TRUE(waitForLine("WAKELOG 1", std::chrono::milliseconds(500)));
+
+    //2. Every flush policy still writes before the writer goes back to sleep
+    for (auto policy : {LogFlushPolicy::Interval, LogFlushPolicy::OnError, LogFlushPolicy::PerBatch}) {
+        Logger::getInstance().setFlushPolicy(policy, std::chrono::milliseconds(50));
+        LOG_WARN("POLICYLOG {}", static_cast<int>(policy));
+        EXPECT_TRUE(waitForLine("POLICYLOG " + std::to_string(static_cast<int>(policy)), std::chrono::milliseconds(500)));
+    }
+}
+
+namespace {
+    // Lines of the rotated files (gzipped, in the archive) after startFile, then of the live file
+    std::vector<std::string> linesSince(const fs::path& startFile) {
+        std::vector<fs::path> archived;
+        for (auto& entry : fs::directory_iterator(startFile.parent_path() / "archive")) {
+            fs::path path = entry.path();
+            if (path.extension() == ".gz" && path.stem().string() >= startFile.filename().string())
+                archived.push_back(path);
+        }
+        std::sort(archived.begin(), archived.end());
+
+        std::vector<std::string> lines;
+        char buffer[1024];
+        for (auto& path : archived) {
+            gzFile in = gzopen(path.c_str(), "rb");
+            while (in && gzgets(in, buffer, sizeof(buffer)))
+                lines.emplace_back(buffer);
+            if (in)
+                gzclose(in);
+        }
+        std::ifstream live(Logger::getInstance().getLogFileName());
+        std::string line;
+        while (std::getline(live, line))
+            lines.push_back(line);
+        return lines;
+    }
+}
+
+TEST(LoggerTest, RotatesAndArchivesWithoutLosingLines)
+{
+    Logger& logger = Logger::getInstance();
+    logger.setLogLevel(LogLevel::INFO);
+    fs::path startFile = logger.getLogFileName();
+    const int MESSAGES = 1000;
+
+    //1. ~100 bytes a line. Files only switch between batches, waiting after every
+    //   100 lines makes sure there are several.
+    logger.setRotation(4096, std::chrono::seconds(0));
+    for (int i = 0; i < MESSAGES; ++i) {
+        LOG_INFO("ROTLOG seq {} padding {}", i, "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx");
+        if (i % 100 == 99) {
+            ASSERT_TRUE(waitForLine("ROTLOG seq " + std::to_string(i) + " ", std::chrono::milliseconds(1000)));
+        }
+    }
+    logger.setRotation(LOG_ROTATE_BYTES, std::chrono::seconds(LOG_ROTATE_SECONDS));
+    EXPECT_NE(logger.getLogFileName(), startFile.string());
+
+    //2. Once the archiver caught up, every line is in exactly one file, in order
+    std::vector<int> expected(MESSAGES);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::vector<int> seen;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    do {
+        // A file being compressed reads short, so retry until complete
+        seen.clear();
+        for (auto& line : linesSince(startFile)) {
+            size_t pos = line.find("ROTLOG seq ");
+            if (pos != std::string::npos)
+                seen.push_back(std::stoi(line.substr(pos + 11)));
+        }
+        if (seen == expected)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    } while (std::chrono::steady_clock::now() < deadline);
+    EXPECT_EQ(seen, expected);
+
+    //3. The first file left the live directory and was compressed
+    EXPECT_FALSE(fs::exists(startFile));
+    EXPECT_TRUE(fs::exists(startFile.parent_path() / "archive" / (startFile.filename().string() + ".gz")));
+}
+
+TEST(LogArchiverTest, CompressRoundTrips)
+{
+    fs::path dir = fs::temp_directory_path() / "log_archiver_test";
+    fs::create_directories(dir);
+    std::string source = (dir / "plain.log").string();
+    std::string target = source + ".gz";
+    {
+        std::ofstream out(source);
+        for (int i = 0; i < 10000; ++i)
+            out << "line " << i << "\n";
+    }
+
+    ASSERT_TRUE(LogArchiver::compress(source, target));
+    EXPECT_LT(fs::file_size(target), fs::file_size(source));
+
+    gzFile in = gzopen(target.c_str(), "rb");
+    ASSERT_NE(in, nullptr);
+    char buffer[64];
+    int count = 0;
+    while (gzgets(in, buffer, sizeof(buffer)))
+        EXPECT_EQ(std::string(buffer), "line " + std::to_string(count++) + "\n");
+    gzclose(in);
+    EXPECT_EQ(count, 10000);
+
+    EXPECT_FALSE(LogArchiver::compress((dir / "missing.log").string(), target));
+    fs::remove_all(dir);
+}
@@ -1,5 +1,14 @@
 #include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include "StaticMemoryPool.hpp"
+#include "HeapMemoryPool.hpp"
+#include "ConcurrentObjectPool.hpp"
+#include "LockFreeQueue.hpp"
 
 namespace {
     class TestObject {
@@ -59,4 +68,146 @@ static void BM_NewDelete(benchmark::State& state) {
 }
 BENCHMARK(BM_NewDelete);
 
+// Steady state of a nearly full pool: every iteration frees one live object and
+// allocates a replacement. The freed slot moves around the pool, so a scan for the
+// next free slot would show up as latency growing with N.
+template<size_t N>
+static void BM_StaticMemoryPoolSteadyState(benchmark::State& state) {
+    auto pool = std::make_unique<StaticMemoryPool<TestObject, N>>();
+    std::vector<TestObject*> live;
+    live.reserve(N);
+    for (size_t i = 0; i < N; ++i)
+        live.push_back(pool->alloc(static_cast<int>(i), "steady"));
+    // Leave one slot in 64 free
+    for (size_t i = 0; i < N; i += 64) {
+        pool->free(live[i]);
+        live[i] = nullptr;
+    }
+
+    uint64_t victim = 1;
+    for (auto _ : state) {
+        // A scrambled walk over the live objects, never the same cache line twice in a row
+        victim = (victim * 6364136223846793005ull + 1442695040888963407ull);
+        size_t index = static_cast<size_t>(victim >> 33) % N;
+        if (live[index] == nullptr)
+            index = (index + 1) % N;
+        pool->free(live[index]);
+        live[index] = pool->alloc(42, "steady");
+        benchmark::DoNotOptimize(live[index]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_StaticMemoryPoolSteadyState, 1024);
+BENCHMARK_TEMPLATE(BM_StaticMemoryPoolSteadyState, 65536);
+BENCHMARK_TEMPLATE(BM_StaticMemoryPoolSteadyState, 1048576);
+
+// Same pattern as BM_StaticMemoryPoolAllocFree, but the pool starts with 64 slots per
+// slab and grows while the 1000 objects are allocated
+static void BM_HeapMemoryPoolAllocFree(benchmark::State& state) {
+    HeapMemoryPool<TestObject> pool(64);
+
+    for (auto _ : state) {
+        std::vector<TestObject*> pointers;
+        for (int i=0; i < 1000; ++i) {
+            TestObject* p = pool.allocate(42, "benchmark_object");
+            pointers.push_back(p);
+        }
+        benchmark::DoNotOptimize(pointers);
+        // delete odd numbers
+        for (int i = 1; i < 1000; i += 2) {
+            pool.deallocate(pointers[i]);
+            pointers[i] = pool.allocate(43, "realloc_object");
+        }
+        // delete even numbers
+        for (int i = 0; i < 1000; i++) {
+            pool.deallocate(pointers[i]);
+        }
+    }
+}
+BENCHMARK(BM_HeapMemoryPoolAllocFree);
+
+// Steady state of a reserved pool, as BM_StaticMemoryPoolSteadyState
+template<size_t N>
+static void BM_HeapMemoryPoolSteadyState(benchmark::State& state) {
+    HeapMemoryPool<TestObject> pool(4096);
+    pool.reserve(N);
+    std::vector<TestObject*> live;
+    live.reserve(N);
+    for (size_t i = 0; i < N; ++i)
+        live.push_back(pool.allocate(static_cast<int>(i), "steady"));
+
+    uint64_t victim = 1;
+    for (auto _ : state) {
+        victim = (victim * 6364136223846793005ull + 1442695040888963407ull);
+        size_t index = static_cast<size_t>(victim >> 33) % N;
+        pool.deallocate(live[index]);
+        live[index] = pool.allocate(42, "steady");
+        benchmark::DoNotOptimize(live[index]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_HeapMemoryPoolSteadyState, 1024);
+BENCHMARK_TEMPLATE(BM_HeapMemoryPoolSteadyState, 65536);
+BENCHMARK_TEMPLATE(BM_HeapMemoryPoolSteadyState, 1048576);
+
+/*
+Alloc here, free there: the benchmark thread allocates and hands every object to a
+consumer thread through an SPSC queue, the consumer frees it. The single-threaded pools
+can only be shared behind a mutex, which is what they pay here.
+*/
+namespace {
+    struct NewDeleteAllocator {
+        TestObject* allocate() { return new TestObject(42, "handoff"); }
+        void deallocate(TestObject* obj) { delete obj; }
+    };
+
+    struct ConcurrentPoolAllocator {
+        ConcurrentObjectPool<TestObject> pool;
+        TestObject* allocate() { return pool.allocate(42, "handoff"); }
+        void deallocate(TestObject* obj) { pool.deallocate(obj); }
+    };
+
+    struct LockedStaticPoolAllocator {
+        std::mutex mutex;
+        StaticMemoryPool<TestObject, 4096> pool;
+        TestObject* allocate() { std::lock_guard lock(mutex); return pool.alloc(42, "handoff"); }
+        void deallocate(TestObject* obj) { std::lock_guard lock(mutex); pool.free(obj); }
+    };
+
+    struct LockedHeapPoolAllocator {
+        std::mutex mutex;
+        HeapMemoryPool<TestObject> pool{1024};
+        TestObject* allocate() { std::lock_guard lock(mutex); return pool.allocate(42, "handoff"); }
+        void deallocate(TestObject* obj) { std::lock_guard lock(mutex); pool.deallocate(obj); }
+    };
+}
+
+template<typename Allocator>
+static void BM_HandoffAllocFree(benchmark::State& state) {
+    auto allocator = std::make_unique<Allocator>();
+    LockFreeQueue<TestObject*, 1024> handoff;
+    std::atomic<bool> done = false;
+
+    std::thread consumer([&] {
+        auto release = [&](TestObject*& obj) { allocator->deallocate(obj); };
+        while (!done.load(std::memory_order_acquire)) {
+            if (!handoff.consume(release))
+                CPU_RELAX();
+        }
+        while (handoff.consume(release)) {}
+    });
+    for (auto _ : state) {
+        TestObject* obj = allocator->allocate();
+        while (!handoff.try_push(obj))
+            CPU_RELAX();
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_HandoffAllocFree, NewDeleteAllocator)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HandoffAllocFree, ConcurrentPoolAllocator)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HandoffAllocFree, LockedStaticPoolAllocator)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_HandoffAllocFree, LockedHeapPoolAllocator)->UseRealTime();
+
 BENCHMARK_MAIN();
@@ -1,5 +1,12 @@
 #include "StaticMemoryPool.hpp"
+#include "HeapMemoryPool.hpp"
+#include "ConcurrentObjectPool.hpp"
+#include "LockFreeQueue.hpp"
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
  #include <gtest/gtest.h>
 
 //  Unit tests for MemoryPool classes.
@@ -143,8 +150,182 @@ TEST(MemoryPoolTest, StaticMemoryPoolAllocationDeallocation) {
     EXPECT_EQ(TestObject::destructorCallCount, currentDestructorCount);
 }
 
-TEST(MemoryPoolTest, HeapMemoryPoolBasicAllocationDeallocation) {
-    // This test is a placeholder for HeapMemoryPool tests.
-    // Implement similar tests for HeapMemoryPool as done for StaticMemoryPool.
-    SUCCEED();
-}
\ No newline at end of file
+TEST(MemoryPoolTest, StaticMemoryPoolReusesLowestFreeSlotAcrossLevels) {
+    // 8192 slots: three bitmap levels, the top one only partly used
+    constexpr size_t SLOTS = 8192;
+    auto pool = std::make_unique<StaticMemoryPool<uint64_t, SLOTS>>();
+
+    //1. Fill it, slots are handed out in address order
+    std::vector<uint64_t*> slots;
+    for (size_t i = 0; i < SLOTS; ++i)
+        slots.push_back(pool->alloc(i));
+    for (size_t i = 1; i < SLOTS; ++i)
+        EXPECT_EQ(slots[i], slots[i - 1] + 1);
+    EXPECT_THROW(pool->alloc(0), std::runtime_error);
+
+    //2. Free a scattered set, including whole 64-slot words and the very last slot
+    std::vector<size_t> freed = {8191, 4095, 4096, 77, 5000, 12};
+    for (size_t i = 128; i < 192; ++i)
+        freed.push_back(i);
+    for (size_t index : freed)
+        pool->free(slots[index]);
+
+    //3. Every alloc now returns the lowest free slot
+    std::sort(freed.begin(), freed.end());
+    for (size_t index : freed)
+        EXPECT_EQ(pool->alloc(0), slots[index]);
+    EXPECT_THROW(pool->alloc(0), std::runtime_error);
+}
+
+TEST(MemoryPoolTest, HeapMemoryPoolAllocationDeallocation) {
+    TestObject::destructorCallCount = 0;
+    {
+        HeapMemoryPool<TestObject> pool(4);
+
+        //1. Allocate past the first slab, objects created earlier keep their address and value
+        std::vector<TestObject*> objects;
+        for (int i = 0; i < 100; ++i)
+            objects.push_back(pool.allocate(i, "obj" + std::to_string(i)));
+        EXPECT_EQ(pool.size(), 100u);
+        EXPECT_EQ(pool.slabCount(), 25u);
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_EQ(objects[i]->intParam(), i);
+            EXPECT_EQ(objects[i]->strParam(), "obj" + std::to_string(i));
+        }
+
+        //2. A freed slot is the next one handed out
+        TestObject* freed = objects[37];
+        pool.deallocate(freed);
+        EXPECT_EQ(TestObject::destructorCallCount, 1);
+        objects[37] = pool.allocate(370, "again");
+        EXPECT_EQ(objects[37], freed);
+        EXPECT_EQ(pool.slabCount(), 25u);
+
+        //3. Double, foreign and misaligned pointers throw and destroy nothing
+        pool.deallocate(objects[99]);
+        EXPECT_THROW(pool.deallocate(objects[99]), std::runtime_error);
+        TestObject foreign(1, "foreign");
+        EXPECT_THROW(pool.deallocate(&foreign), std::runtime_error);
+        auto* misaligned = reinterpret_cast<TestObject*>(reinterpret_cast<char*>(objects[10]) + 1);
+        EXPECT_THROW(pool.deallocate(misaligned), std::runtime_error);
+        EXPECT_EQ(TestObject::destructorCallCount, 2);
+        EXPECT_EQ(pool.size(), 99u);
+    }
+    //4. The pool destroys what is still allocated, plus foreign itself
+    EXPECT_EQ(TestObject::destructorCallCount, 2 + 99 + 1);
+}
+
+TEST(MemoryPoolTest, HeapMemoryPoolReserveDoesNotMoveObjects) {
+    HeapMemoryPool<uint64_t> pool(1000);
+    uint64_t* first = pool.allocate(uint64_t{7});
+
+    //1. Reserving adds whole slabs, the first object stays put
+    pool.reserve(5000);
+    EXPECT_EQ(pool.capacity(), 5000u);
+    EXPECT_EQ(pool.slabCount(), 5u);
+    EXPECT_EQ(*first, 7u);
+
+    //2. Filling the reserved capacity does not add slabs, slots are never handed out twice
+    std::vector<uint64_t*> values = {first};
+    for (uint64_t i = 1; i < 5000; ++i)
+        values.push_back(pool.allocate(i));
+    EXPECT_EQ(pool.slabCount(), 5u);
+    std::vector<uint64_t*> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(std::adjacent_find(sorted.begin(), sorted.end()), sorted.end());
+
+    //3. Every slot can be freed again, whichever slab it is in
+    for (uint64_t* value : values)
+        pool.deallocate(value);
+    EXPECT_EQ(pool.size(), 0u);
+    pool.allocate(uint64_t{1});
+    EXPECT_EQ(pool.slabCount(), 5u);
+}
+
+TEST(MemoryPoolTest, ConcurrentObjectPoolSameThread) {
+    TestObject::destructorCallCount = 0;
+    {
+        ConcurrentObjectPool<TestObject> pool(8);
+
+        //1. Freed objects are reused by the same thread, LIFO
+        TestObject* first = pool.allocate(1, "first");
+        TestObject* second = pool.allocate(2, "second");
+        EXPECT_EQ(first->strParam(), "first");
+        EXPECT_EQ(second->intParam(), 2);
+        pool.deallocate(second);
+        EXPECT_EQ(TestObject::destructorCallCount, 1);
+        EXPECT_EQ(pool.allocate(3, "third"), second);
+
+        //2. A double free throws and destroys nothing
+        pool.deallocate(first);
+        EXPECT_THROW(pool.deallocate(first), std::runtime_error);
+        EXPECT_EQ(TestObject::destructorCallCount, 2);
+
+        //3. Freeing many objects moves whole batches to the depot
+        std::vector<TestObject*> objects;
+        for (int i = 0; i < 100; ++i)
+            objects.push_back(pool.allocate(i, "obj"));
+        for (TestObject* obj : objects)
+            pool.deallocate(obj);
+        EXPECT_GT(pool.depotBatchCount(), 0u);
+        EXPECT_EQ(pool.threadCacheCount(), 1u);
+    }
+    //4. The object still allocated (third) is destroyed with the pool
+    EXPECT_EQ(TestObject::destructorCallCount, 2 + 100 + 1);
+}
+
+TEST(MemoryPoolTest, ConcurrentObjectPoolAllocHereFreeThere) {
+    constexpr uint64_t COUNT = 200000;
+    ConcurrentObjectPool<uint64_t> pool(64);
+    LockFreeQueue<uint64_t*, 1024> handoff;
+
+    //1. Allocate on this thread, free on the consumer
+    std::jthread consumer([&] {
+        uint64_t expected = 0;
+        while (expected < COUNT) {
+            if (!handoff.consume([&](uint64_t*& value) {
+                    EXPECT_EQ(*value, expected);
+                    ++expected;
+                    pool.deallocate(value);
+                }))
+                CPU_RELAX();
+        }
+        pool.flushRemoteFrees();
+    });
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        uint64_t* value = pool.allocate(i);
+        while (!handoff.try_push(value))
+            CPU_RELAX();
+    }
+    consumer.join();
+
+    //2. Memory came back to the producer: at most queue + a few batches were ever live
+    EXPECT_LE(pool.slabCount(), 1024 / 64 + 4);
+    EXPECT_EQ(pool.threadCacheCount(), 2u);
+}
+
+TEST(MemoryPoolTest, ConcurrentObjectPoolAdoptsCacheOfExitedThread) {
+    ConcurrentObjectPool<uint64_t> pool(16, 2);
+
+    //1. A thread allocates, frees everything and exits; the depot stays bounded
+    std::jthread([&] {
+        std::vector<uint64_t*> values;
+        for (uint64_t i = 0; i < 1000; ++i)
+            values.push_back(pool.allocate(i));
+        for (uint64_t* value : values)
+            pool.deallocate(value);
+        EXPECT_EQ(pool.depotBatchCount(), 2u);
+    }).join();
+    size_t slabs = pool.slabCount();
+
+    //2. The next thread takes its cache over, with the memory in it
+    std::jthread([&] {
+        std::vector<uint64_t*> values;
+        for (uint64_t i = 0; i < 1000; ++i)
+            values.push_back(pool.allocate(i));
+        for (uint64_t* value : values)
+            pool.deallocate(value);
+    }).join();
+    EXPECT_EQ(pool.threadCacheCount(), 1u);
+    EXPECT_EQ(pool.slabCount(), slabs);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+#include "MemoryResource.hpp"
+#include "FixMessage.h"
+#include "FixMessageView.h"
+
+/*
+Allocation counting hook: every global operator new in this test binary goes through
+here, so a test can check that a code path never reaches malloc.
+*/
+namespace {
+    std::atomic<size_t> g_heapAllocations = 0;
+
+    void* countedAllocation(size_t size) {
+        g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* ptr = std::malloc(size == 0 ? 1 : size))
+            return ptr;
+        throw std::bad_alloc();
+    }
+
+    void* countedAllocation(size_t size, std::align_val_t alignment) {
+        g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        size_t align = static_cast<size_t>(alignment);
+        if (void* ptr = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align))
+            return ptr;
+        throw std::bad_alloc();
+    }
+
+    // Out of line, or GCC pairs the free() with the replaced operator new and warns
+    [[gnu::noinline]] void countedFree(void* ptr) noexcept { std::free(ptr); }
+}
+
+void* operator new(size_t size) { return countedAllocation(size); }
+void* operator new[](size_t size) { return countedAllocation(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return countedAllocation(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return countedAllocation(size, alignment); }
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { countedFree(ptr); }
+
+TEST(MemoryResourceTest, ArenaResetReusesItsChunks) {
+    // Chunks carved from a 64-aligned buffer, so alignment padding, and with it the
+    // chunk count below, does not depend on where malloc puts them
+    alignas(64) static std::byte backing[8192];
+    std::pmr::monotonic_buffer_resource upstream(backing, sizeof(backing), std::pmr::null_memory_resource());
+    MessageArena arena(256, &upstream);
+
+    //1. Allocations are aligned and bump forward
+    void* first = arena.allocate(10, 1);
+    void* aligned = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+    EXPECT_GT(aligned, first);
+
+    //2. Past the first chunk a bigger one is added, even for a request larger than it
+    void* spill = arena.allocate(200, 8);
+    void* large = arena.allocate(2000, 8);
+    EXPECT_EQ(arena.chunkCount(), 3u);
+    EXPECT_EQ(arena.used(), 72u + 200u + 2000u);
+
+    //3. reset() rewinds: same addresses again, no new chunk, no heap allocation
+    size_t allocations = g_heapAllocations.load();
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    void* again = arena.allocate(10, 1);
+    void* alignedAgain = arena.allocate(8, 64);
+    void* spillAgain = arena.allocate(200, 8);
+    void* largeAgain = arena.allocate(2000, 8);
+    size_t newAllocations = g_heapAllocations.load() - allocations;
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(alignedAgain, aligned);
+    EXPECT_EQ(spillAgain, spill);
+    EXPECT_EQ(largeAgain, large);
+    EXPECT_EQ(arena.chunkCount(), 3u);
+    EXPECT_EQ(newAllocations, 0u);
+
+    //4. release() keeps only the first chunk
+    arena.release();
+    EXPECT_EQ(arena.chunkCount(), 1u);
+    EXPECT_EQ(arena.capacity(), 256u);
+}
+
+TEST(MemoryResourceTest, PoolResourcesServeBlocksAndForwardTheRest) {
+    auto staticPool = std::make_unique<StaticBlockPool<64, 128>>();
+    StaticPoolResource<64, 128> staticResource(*staticPool);
+    HeapMemoryPool<ResourceBlock<64>> heapPool(32);
+    heapPool.reserve(100);
+    HeapPoolResource<64> heapResource(heapPool);
+
+    //1. List nodes fit a block, none of them reach the heap
+    size_t allocations = g_heapAllocations.load();
+    size_t listAllocations;
+    {
+        std::pmr::list<int> fromStatic(&staticResource);
+        std::pmr::list<int> fromHeapPool(&heapResource);
+        for (int i = 0; i < 100; ++i) {
+            fromStatic.push_back(i);
+            fromHeapPool.push_back(i);
+        }
+        listAllocations = g_heapAllocations.load() - allocations;
+        EXPECT_EQ(fromStatic.back(), 99);
+        EXPECT_EQ(fromHeapPool.front(), 0);
+    }
+    EXPECT_EQ(listAllocations, 0u);
+    EXPECT_EQ(heapPool.size(), 0u);
+    EXPECT_EQ(heapPool.slabCount(), 4u);
+
+    //2. A request bigger than a block goes upstream
+    allocations = g_heapAllocations.load();
+    void* big = staticResource.allocate(1000, 8);
+    size_t bigAllocations = g_heapAllocations.load() - allocations;
+    EXPECT_EQ(bigAllocations, 1u);
+    staticResource.deallocate(big, 1000, 8);
+
+    //3. A full static pool reports bad_alloc
+    std::vector<void*> blocks;
+    for (int i = 0; i < 128; ++i)
+        blocks.push_back(staticResource.allocate(64, 8));
+    EXPECT_THROW(static_cast<void>(staticResource.allocate(64, 8)), std::bad_alloc);
+    for (void* block : blocks)
+        staticResource.deallocate(block, 64, 8);
+}
+
+TEST(MemoryResourceTest, MessageOnArenaDoesNotMallocInSteadyState) {
+    // Two group instances of NoMDEntries, as the parser would have located them
+    const std::string instances = "269=0\x01" "270=101.5\x01" "269=1\x01" "270=101.75\x01";
+    MessageArena arena;
+
+    auto handleMessage = [&] {
+        arena.reset();
+        FixMessageView view(&arena);
+        view.addField(8, "FIX.4.4");
+        view.addField(35, "W");
+        view.addField(268, "2");
+        view.beginGroup('\x01');
+        view.addGroupInstance(instances.data());
+        view.addGroupInstance(instances.data() + 16);
+        view.endGroup(instances.data() + instances.size());
+
+        FixMessage msg = view.toFixMessage(&arena);
+        // Past the inline entries, so the overflow vector is used too
+        for (int tag = 5000; tag < 5100; ++tag)
+            msg.addField(tag, "some value long enough not to fit the small string buffer");
+        std::pmr::string text(&arena);
+        for (size_t i = 0; i < msg.fieldCount(); ++i)
+            text.append(msg.field(i).value);
+        return msg.fieldCount() + text.size();
+    };
+
+    //1. The first message grows the arena
+    size_t expected = handleMessage();
+
+    //2. After that, not a single heap allocation per message
+    size_t allocations = g_heapAllocations.load();
+    size_t total = 0;
+    for (int i = 0; i < 1000; ++i)
+        total += handleMessage();
+    size_t newAllocations = g_heapAllocations.load() - allocations;
+    EXPECT_EQ(newAllocations, 0u);
+    EXPECT_EQ(total, expected * 1000);
+}
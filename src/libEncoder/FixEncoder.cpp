@@ -0,0 +1,242 @@
+#include "FixEncoder.h"
+#include "FixChecksum.h"
+#include "FixTags.h"
+#include "Macros.h"
+#include <cassert>
+#include <charconv>
+#include <cstring>
+
+namespace {
+    constexpr char SOH = '\x01';
+
+    // Appends to a small stack buffer while building the header prefix
+    struct PrefixWriter {
+        char* out;
+        size_t size = 0;
+
+        void put(std::string_view bytes) {
+            std::memcpy(out + size, bytes.data(), bytes.size());
+            size += bytes.size();
+        }
+        void put(uint64_t value) {
+            size = std::to_chars(out + size, out + FIX_ENCODER_HEADROOM, value).ptr - out;
+        }
+    };
+}
+
+FixEncoder::FixEncoder(std::string_view beginString, std::string_view senderCompId, std::string_view targetCompId,
+                       FixTimePrecision sendingTimePrecision)
+    : _beginString(beginString)
+    , _clock(sendingTimePrecision)
+{
+    assert(beginString.size() <= 16 && "FixEncoder: BeginString does not fit the header headroom");
+
+    _sessionFields.append("49=").append(senderCompId).push_back(SOH);
+    _sessionFields.append("56=").append(targetCompId).push_back(SOH);
+    _sessionFieldsSum = fixByteSum(_sessionFields);
+}
+
+void FixEncoder::appendPresummed(std::string_view bytes, uint32_t sum)
+{
+    if (UNLIKELY(!_status))
+        return;
+    if (UNLIKELY(_cursor + bytes.size() > _buffer.size())) {
+        _status = std::unexpected(FixError::BufferTooSmall);
+        return;
+    }
+    std::memcpy(_buffer.data() + _cursor, bytes.data(), bytes.size());
+    _sum += sum;
+    _cursor += bytes.size();
+}
+
+void FixEncoder::appendField(int tag, std::string_view value)
+{
+    if (UNLIKELY(!_status))
+        return;
+    if (UNLIKELY(tag <= 0)) {
+        _status = std::unexpected(FixError::InvalidTag);
+        return;
+    }
+    // Longest positive tag is 10 digits, plus '=' and SOH
+    if (UNLIKELY(_cursor + value.size() + 12 > _buffer.size())) {
+        _status = std::unexpected(FixError::BufferTooSmall);
+        return;
+    }
+    char* first = _buffer.data() + _cursor;
+    char* out = std::to_chars(first, first + 11, tag).ptr;
+    *out++ = '=';
+
+    uint32_t sum = _sum + fixByteSum(std::string_view(first, out - first)) + SOH;
+    // Copy and checksum the value in the same loop
+    for (char c : value) {
+        *out++ = c;
+        sum += static_cast<unsigned char>(c);
+    }
+    *out++ = SOH;
+
+    _sum = sum;
+    _cursor = out - _buffer.data();
+}
+
+void FixEncoder::begin(std::span<char> buffer, std::string_view msgType, uint64_t seqNum, std::string_view sendingTime)
+{
+    // A failed begin() leaves no buffer behind, every later call only reports the error
+    _buffer = {};
+    _cursor = 0;
+    _sum = 0;
+    _seqNum = seqNum;
+    _status = {};
+    _current = FixEncodedMessage{};
+
+    if (UNLIKELY(buffer.size() < FIX_ENCODER_HEADROOM)) {
+        _status = std::unexpected(FixError::BufferTooSmall);
+        return;
+    }
+    if (UNLIKELY(msgType.empty() || msgType.size() > FIX_ENCODER_MAX_MSG_TYPE)) {
+        _status = std::unexpected(FixError::InvalidValue);
+        return;
+    }
+
+    _buffer = buffer;
+    _cursor = FIX_ENCODER_HEADROOM;
+
+    _current._buffer = buffer.data();
+    _current._bodyStart = static_cast<uint32_t>(FIX_ENCODER_HEADROOM);
+    std::memcpy(_current._msgType, msgType.data(), msgType.size());
+    _current._msgTypeLength = static_cast<uint8_t>(msgType.size());
+
+    // "52=" is three bytes, the value follows
+    _current._sendingTime = static_cast<uint32_t>(_cursor + 3);
+    _current._sendingTimeLength = static_cast<uint32_t>(sendingTime.size());
+    appendField(FixTag::SendingTime, sendingTime);
+
+    appendPresummed(_sessionFields, _sessionFieldsSum);
+}
+
+void FixEncoder::begin(std::span<char> buffer, std::string_view msgType, uint64_t seqNum)
+{
+    begin(buffer, msgType, seqNum, _clock.now());
+}
+
+void FixEncoder::addField(int tag, std::string_view value)
+{
+    appendField(tag, value);
+}
+
+void FixEncoder::addField(int tag, const FixDecimal& value)
+{
+    if (UNLIKELY(!_status))
+        return;
+    if (UNLIKELY(value.exponent < -FixDecimal::MAX_DIGITS || value.exponent > FixDecimal::MAX_DIGITS)) {
+        _status = std::unexpected(FixError::InvalidValue);
+        return;
+    }
+
+    char digits[24];
+    uint64_t magnitude = value.mantissa < 0 ? 0 - static_cast<uint64_t>(value.mantissa) : static_cast<uint64_t>(value.mantissa);
+    size_t count = std::to_chars(digits, digits + sizeof(digits), magnitude).ptr - digits;
+
+    // sign + "0." + leading zeros + digits + trailing zeros all fit in 64 bytes
+    char text[64];
+    size_t size = 0;
+    if (value.mantissa < 0)
+        text[size++] = '-';
+
+    size_t fraction = value.exponent < 0 ? static_cast<size_t>(-value.exponent) : 0;
+    if (fraction == 0) {
+        std::memcpy(text + size, digits, count);
+        size += count;
+        for (int i = 0; i < value.exponent; ++i)
+            text[size++] = '0';
+    } else if (count > fraction) {
+        std::memcpy(text + size, digits, count - fraction);
+        size += count - fraction;
+        text[size++] = '.';
+        std::memcpy(text + size, digits + count - fraction, fraction);
+        size += fraction;
+    } else {
+        text[size++] = '0';
+        text[size++] = '.';
+        for (size_t i = count; i < fraction; ++i)
+            text[size++] = '0';
+        std::memcpy(text + size, digits, count);
+        size += count;
+    }
+
+    appendField(tag, std::string_view(text, size));
+}
+
+uint32_t FixEncoder::writeHeaderPrefix(FixEncodedMessage& msg, uint64_t seqNum) const
+{
+    // "35=..|34=..|" belongs to the body, so it is built first to know BodyLength
+    char body[FIX_ENCODER_HEADROOM];
+    PrefixWriter bodyPart{body};
+    bodyPart.put("35=");
+    bodyPart.put(std::string_view(msg._msgType, msg._msgTypeLength));
+    bodyPart.put("\x01" "34=");
+    bodyPart.put(seqNum);
+    bodyPart.put("\x01");
+
+    char prefix[FIX_ENCODER_HEADROOM];
+    PrefixWriter header{prefix};
+    header.put("8=");
+    header.put(_beginString);
+    header.put("\x01" "9=");
+    header.put(static_cast<uint64_t>(bodyPart.size + (msg._trailer - msg._bodyStart)));
+    header.put("\x01");
+    header.put(std::string_view(body, bodyPart.size));
+
+    assert(header.size <= msg._bodyStart && "FixEncoder: header prefix exceeds the headroom");
+    msg._start = msg._bodyStart - static_cast<uint32_t>(header.size);
+    std::memcpy(msg._buffer + msg._start, prefix, header.size);
+    return fixByteSum(std::string_view(prefix, header.size));
+}
+
+void FixEncoder::writeTrailer(FixEncodedMessage& msg, uint32_t sum)
+{
+    uint8_t checksum = static_cast<uint8_t>(sum & 0xFF);
+    char* out = msg._buffer + msg._trailer;
+    out[0] = '1';
+    out[1] = '0';
+    out[2] = '=';
+    out[3] = static_cast<char>('0' + checksum / 100);
+    out[4] = static_cast<char>('0' + (checksum / 10) % 10);
+    out[5] = static_cast<char>('0' + checksum % 10);
+    out[6] = SOH;
+}
+
+std::expected<FixEncodedMessage, FixError> FixEncoder::finish()
+{
+    if (UNLIKELY(!_status))
+        return std::unexpected(_status.error());
+    if (UNLIKELY(_cursor + 7 > _buffer.size()))
+        return std::unexpected(FixError::BufferTooSmall);
+
+    _current._trailer = static_cast<uint32_t>(_cursor);
+    _current._bodySum = _sum;
+    uint32_t prefixSum = writeHeaderPrefix(_current, _seqNum);
+    writeTrailer(_current, prefixSum + _current._bodySum);
+    return _current;
+}
+
+std::expected<void, FixError> FixEncoder::patchHeader(FixEncodedMessage& msg, uint64_t seqNum, std::string_view sendingTime) const
+{
+    if (UNLIKELY(msg._buffer == nullptr))
+        return std::unexpected(FixError::EmptyMessage);
+    if (UNLIKELY(sendingTime.size() != msg._sendingTimeLength))
+        return std::unexpected(FixError::InvalidValue);
+
+    // Adjust the body sum by the difference instead of summing the body again
+    char* time = msg._buffer + msg._sendingTime;
+    msg._bodySum += fixByteSum(sendingTime) - fixByteSum(std::string_view(time, msg._sendingTimeLength));
+    std::memcpy(time, sendingTime.data(), sendingTime.size());
+
+    uint32_t prefixSum = writeHeaderPrefix(msg, seqNum);
+    writeTrailer(msg, prefixSum + msg._bodySum);
+    return {};
+}
+
+std::expected<void, FixError> FixEncoder::patchHeader(FixEncodedMessage& msg, uint64_t seqNum)
+{
+    return patchHeader(msg, seqNum, _clock.now());
+}
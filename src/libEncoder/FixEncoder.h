@@ -0,0 +1,118 @@
+#pragma once
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include "Errors.h"
+#include "FixDecimal.h"
+#include "FixTimestamp.h"
+
+// Space kept in front of the body for "8=..|9=..|35=..|34=..|", which is written last
+static const size_t FIX_ENCODER_HEADROOM = 80;
+static const size_t FIX_ENCODER_MAX_MSG_TYPE = 8;
+
+/*
+Location of one encoded message inside the caller's buffer.
+Besides the bytes it remembers where the fields that change between sends are,
+so FixEncoder::patchHeader can restamp MsgSeqNum and SendingTime in place.
+*/
+class FixEncodedMessage {
+    friend class FixEncoder;
+
+    char* _buffer = nullptr;
+    uint32_t _start = 0;            // "8=" of the message
+    uint32_t _bodyStart = 0;        // first byte after "34=<seq><SOH>", nothing before it moves on patch
+    uint32_t _sendingTime = 0;      // value of tag 52
+    uint32_t _sendingTimeLength = 0;
+    uint32_t _trailer = 0;          // "10=" of the message
+    uint32_t _bodySum = 0;          // byte sum of [_bodyStart, _trailer)
+    char _msgType[FIX_ENCODER_MAX_MSG_TYPE] = {};
+    uint8_t _msgTypeLength = 0;
+
+public:
+    std::string_view view() const { return std::string_view(_buffer + _start, _trailer + 7 - _start); }
+    size_t size() const { return _trailer + 7 - _start; }
+};
+
+/*
+Writes FIX messages into a caller provided buffer without allocating.
+One encoder belongs to one session: BeginString, SenderCompID and TargetCompID are
+serialized once at construction. Fields are appended in call order while their byte
+sum is accumulated, so BodyLength and CheckSum come out of finish() without another
+pass over the message. The header in front of MsgSeqNum is written last, right
+aligned against the body, which is why the buffer needs FIX_ENCODER_HEADROOM spare bytes.
+
+    encoder.begin(buffer, "D", seqNum);     // SendingTime from the clock
+    encoder.addField(11, clOrdId);
+    encoder.addField(44, price);
+    auto msg = encoder.finish();
+*/
+class FixEncoder {
+    std::string _beginString;
+    std::string _sessionFields;     // "49=..<SOH>56=..<SOH>"
+    uint32_t _sessionFieldsSum = 0;
+
+    // State of the message being written
+    std::span<char> _buffer;
+    size_t _cursor = 0;
+    uint32_t _sum = 0;              // byte sum of everything written since begin()
+    uint64_t _seqNum = 0;
+    std::expected<void, FixError> _status;
+    FixEncodedMessage _current;
+    FixTimestampFormatter _clock;   // SendingTime when the caller does not pass one
+
+    // Writes "tag=value<SOH>" with a single bounds check and adds it to the byte sum
+    void appendField(int tag, std::string_view value);
+    void appendPresummed(std::string_view bytes, uint32_t sum);
+
+    // Writes "8=..|9=..|35=..|34=..|" right aligned against msg's body, returns its byte sum
+    uint32_t writeHeaderPrefix(FixEncodedMessage& msg, uint64_t seqNum) const;
+    static void writeTrailer(FixEncodedMessage& msg, uint32_t sum);
+
+public:
+    FixEncoder(std::string_view beginString, std::string_view senderCompId, std::string_view targetCompId,
+               FixTimePrecision sendingTimePrecision = FixTimePrecision::Millis);
+
+    // Starts a message, writing SendingTime and the session fields.
+    void begin(std::span<char> buffer, std::string_view msgType, uint64_t seqNum, std::string_view sendingTime);
+    // Same, SendingTime is the current UTC time
+    void begin(std::span<char> buffer, std::string_view msgType, uint64_t seqNum);
+
+    // A tag <= 0 fails the message with FixError::InvalidTag
+    void addField(int tag, std::string_view value);
+    void addField(int tag, const FixDecimal& value);
+
+    // char is written as a single character, bool as Y/N, other integers in decimal
+    template<std::integral T>
+    void addField(int tag, T value);
+
+    // Writes the header prefix, BodyLength and CheckSum.
+    std::expected<FixEncodedMessage, FixError> finish();
+
+    /*
+    Restamps an already encoded message for another send: only MsgSeqNum, SendingTime,
+    BodyLength and CheckSum are rewritten, the body is not read again. sendingTime must
+    have the same length as the one the message was encoded with.
+    */
+    std::expected<void, FixError> patchHeader(FixEncodedMessage& msg, uint64_t seqNum, std::string_view sendingTime) const;
+    // Same, SendingTime is the current UTC time at this encoder's precision
+    std::expected<void, FixError> patchHeader(FixEncodedMessage& msg, uint64_t seqNum);
+};
+
+template<std::integral T>
+void FixEncoder::addField(int tag, T value)
+{
+    char text[24];
+    size_t size = 1;
+    if constexpr (std::same_as<T, bool>) {
+        text[0] = value ? 'Y' : 'N';
+    } else if constexpr (std::same_as<T, char>) {
+        text[0] = value;
+    } else {
+        size = std::to_chars(text, text + sizeof(text), value).ptr - text;
+    }
+    appendField(tag, std::string_view(text, size));
+}
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <chrono>
+#include <format>
+#include "FixEncoder.h"
+#include "FixTags.h"
+
+static void BM_EncodeNewOrderSingle(benchmark::State& state) {
+    FixEncoder encoder("FIX.4.4", "CLIENT_COMP", "BROKER_COMP");
+    std::array<char, 512> buffer;
+    uint64_t seqNum = 1;
+
+    for (auto _ : state) {
+        encoder.begin(buffer, "D", seqNum++, "20240102-09:30:00.123456");
+        encoder.addField(FixTag::ClOrdID, "ORD-0000012345");
+        encoder.addField(1, "ACCOUNT-7");
+        encoder.addField(21, '1');
+        encoder.addField(FixTag::Symbol, "MSFT");
+        encoder.addField(FixTag::Side, '1');
+        encoder.addField(60, "20240102-09:30:00.123456");
+        encoder.addField(FixTag::OrderQty, 500);
+        encoder.addField(40, '2');
+        encoder.addField(FixTag::Price, FixDecimal{41275, -2});
+        encoder.addField(59, '0');
+        auto encoded = encoder.finish();
+        benchmark::DoNotOptimize(encoded);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeNewOrderSingle);
+
+static void BM_PatchHeader(benchmark::State& state) {
+    FixEncoder encoder("FIX.4.4", "CLIENT_COMP", "BROKER_COMP");
+    std::array<char, 512> buffer;
+    encoder.begin(buffer, "D", 1, "20240102-09:30:00.123456");
+    encoder.addField(FixTag::ClOrdID, "ORD-0000012345");
+    encoder.addField(FixTag::Symbol, "MSFT");
+    encoder.addField(FixTag::Side, '1');
+    encoder.addField(FixTag::OrderQty, 500);
+    encoder.addField(FixTag::Price, FixDecimal{41275, -2});
+    auto encoded = encoder.finish();
+    uint64_t seqNum = 2;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encoder.patchHeader(*encoded, seqNum++, "20240102-09:30:00.654321"));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PatchHeader);
+
+// Current SendingTime from the encoder's cached formatter
+static void BM_PatchHeaderFromClock(benchmark::State& state) {
+    FixEncoder encoder("FIX.4.4", "CLIENT_COMP", "BROKER_COMP", FixTimePrecision::Micros);
+    std::array<char, 512> buffer;
+    encoder.begin(buffer, "D", 1);
+    encoder.addField(FixTag::ClOrdID, "ORD-0000012345");
+    encoder.addField(FixTag::Symbol, "MSFT");
+    encoder.addField(FixTag::Side, '1');
+    encoder.addField(FixTag::OrderQty, 500);
+    encoder.addField(FixTag::Price, FixDecimal{41275, -2});
+    auto encoded = encoder.finish();
+    uint64_t seqNum = 2;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encoder.patchHeader(*encoded, seqNum++));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PatchHeaderFromClock);
+
+static void BM_SendingTimeCached(benchmark::State& state) {
+    FixTimestampFormatter clock(FixTimePrecision::Micros);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(clock.now());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SendingTimeCached);
+
+// What the cached formatter replaces
+static void BM_SendingTimeStdFormat(benchmark::State& state) {
+    using namespace std::chrono;
+    for (auto _ : state) {
+        auto now = floor<microseconds>(system_clock::now());
+        benchmark::DoNotOptimize(std::format("{:%Y%m%d-%H:%M:%S}", now));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SendingTimeStdFormat);
+
+BENCHMARK_MAIN();
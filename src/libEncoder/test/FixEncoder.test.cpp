@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+#include "FixEncoder.h"
+#include "FixParser.h"
+#include "FixMessageView.h"
+#include "FixTags.h"
+
+namespace {
+    // Sum of every byte before "10=", modulo 256
+    int expectedChecksum(std::string_view msg) {
+        size_t trailer = msg.rfind("\x01" "10=") + 1;
+        unsigned sum = 0;
+        for (size_t i = 0; i < trailer; ++i) sum += static_cast<unsigned char>(msg[i]);
+        return sum % 256;
+    }
+
+    // Bytes between the end of the BodyLength field and the start of the CheckSum field
+    size_t expectedBodyLength(std::string_view msg) {
+        size_t bodyStart = msg.find('\x01', msg.find("\x01" "9=") + 1) + 1;
+        size_t trailer = msg.rfind("\x01" "10=") + 1;
+        return trailer - bodyStart;
+    }
+
+    void encodeOrder(FixEncoder& encoder, std::span<char> buffer, uint64_t seqNum) {
+        encoder.begin(buffer, "D", seqNum, "20240102-09:30:00.123");
+        encoder.addField(FixTag::ClOrdID, "ORD-42");
+        encoder.addField(21, '1');
+        encoder.addField(FixTag::Symbol, "IBM");
+        encoder.addField(FixTag::Side, '1');
+        encoder.addField(FixTag::OrderQty, 250);
+        encoder.addField(40, '2');
+        encoder.addField(FixTag::Price, FixDecimal{18725, -2});
+        encoder.addField(59, '0');
+    }
+}
+
+TEST(FixEncoderTest, RoundTripThroughParser) {
+    FixEncoder encoder("FIX.4.4", "CLIENT", "BROKER");
+    std::array<char, 512> buffer;
+    encodeOrder(encoder, buffer, 7);
+    auto encoded = encoder.finish();
+    ASSERT_TRUE(encoded.has_value());
+
+    std::string_view msg = encoded->view();
+    EXPECT_TRUE(msg.starts_with("8=FIX.4.4\x01" "9="));
+    EXPECT_TRUE(msg.ends_with("\x01"));
+
+    FixParser parser;
+    FixMessageView view;
+    ASSERT_TRUE(parser.ParseFixMessageView(msg, view).has_value());
+
+    //1. Standard header order: 8, 9, 35 first
+    EXPECT_EQ(view[0].tag, FixTag::BeginString);
+    EXPECT_EQ(view[1].tag, FixTag::BodyLength);
+    EXPECT_EQ(view[2].tag, FixTag::MsgType);
+    EXPECT_EQ(view[view.size() - 1].tag, FixTag::CheckSum);
+
+    //2. Field values
+    EXPECT_EQ(view.getFieldView(FixTag::MsgType), "D");
+    EXPECT_EQ(view.getField<int>(FixTag::MsgSeqNum), 7);
+    EXPECT_EQ(view.getFieldView(FixTag::SenderCompID), "CLIENT");
+    EXPECT_EQ(view.getFieldView(FixTag::TargetCompID), "BROKER");
+    EXPECT_EQ(view.getFieldView(FixTag::SendingTime), "20240102-09:30:00.123");
+    EXPECT_EQ(view.getFieldView(FixTag::Price), "187.25");
+    EXPECT_EQ(view.getFieldView(FixTag::OrderQty), "250");
+
+    //3. BodyLength and CheckSum
+    EXPECT_EQ(view.getField<size_t>(FixTag::BodyLength), expectedBodyLength(msg));
+    EXPECT_EQ(view.getField<int>(FixTag::CheckSum), expectedChecksum(msg));
+    EXPECT_EQ(view.getFieldView(FixTag::CheckSum)->size(), 3);
+}
+
+TEST(FixEncoderTest, PatchHeaderRestampsInPlace) {
+    FixEncoder encoder("FIX.4.2", "CLIENT", "BROKER");
+    std::array<char, 512> buffer;
+    encodeOrder(encoder, buffer, 9);
+    auto encoded = encoder.finish();
+    ASSERT_TRUE(encoded.has_value());
+
+    FixParser parser;
+    FixMessageView view;
+    // 9 -> 10 changes the width of MsgSeqNum and therefore BodyLength
+    for (uint64_t seqNum : {10ULL, 11ULL, 999ULL, 1000ULL, 123456789012ULL}) {
+        ASSERT_TRUE(encoder.patchHeader(*encoded, seqNum, "20240102-09:30:01.456").has_value());
+        std::string_view msg = encoded->view();
+        ASSERT_TRUE(parser.ParseFixMessageView(msg, view).has_value());
+
+        EXPECT_EQ(view.getField<uint64_t>(FixTag::MsgSeqNum), seqNum);
+        EXPECT_EQ(view.getFieldView(FixTag::SendingTime), "20240102-09:30:01.456");
+        EXPECT_EQ(view.getFieldView(FixTag::ClOrdID), "ORD-42");
+        EXPECT_EQ(view.getField<size_t>(FixTag::BodyLength), expectedBodyLength(msg));
+        EXPECT_EQ(view.getField<int>(FixTag::CheckSum), expectedChecksum(msg));
+    }
+
+    // SendingTime must keep its length
+    EXPECT_EQ(encoder.patchHeader(*encoded, 12, "20240102-09:30:01").error(), FixError::InvalidValue);
+}
+
+TEST(FixEncoderTest, StampsSendingTimeFromClock) {
+    FixEncoder encoder("FIX.4.4", "CLIENT", "BROKER", FixTimePrecision::Micros);
+    std::array<char, 512> buffer;
+    FixParser parser;
+    FixMessageView view;
+
+    //1. begin() without a SendingTime takes the current UTC time
+    FixTimestampFormatter reference(FixTimePrecision::Micros);
+    std::string before(reference.now());
+    encoder.begin(buffer, "0", 1);
+    auto encoded = encoder.finish();
+    std::string after(reference.now());
+    ASSERT_TRUE(encoded.has_value());
+    ASSERT_TRUE(parser.ParseFixMessageView(encoded->view(), view).has_value());
+
+    std::string sent(view.getFieldView(FixTag::SendingTime).value());
+    EXPECT_EQ(sent.size(), 24u);
+    EXPECT_LE(before, sent);
+    EXPECT_LE(sent, after);
+
+    //2. patchHeader() restamps with the same length, so it always fits
+    ASSERT_TRUE(encoder.patchHeader(*encoded, 2).has_value());
+    ASSERT_TRUE(parser.ParseFixMessageView(encoded->view(), view).has_value());
+    EXPECT_LE(sent, std::string(view.getFieldView(FixTag::SendingTime).value()));
+    EXPECT_EQ(view.getField<int>(FixTag::CheckSum), expectedChecksum(encoded->view()));
+}
+
+TEST(FixEncoderTest, ValuesAndErrors) {
+    FixEncoder encoder("FIX.4.4", "A", "B");
+    std::array<char, 512> buffer;
+
+    encoder.begin(buffer, "8", 1, "20240102-09:30:00");
+    encoder.addField(FixTag::LastPx, FixDecimal{-5, -3});
+    encoder.addField(FixTag::LastQty, FixDecimal{12, 2});
+    encoder.addField(FixTag::CumQty, FixDecimal{0, 0});
+    encoder.addField(1000, -17);
+    encoder.addField(1001, true);
+    auto encoded = encoder.finish();
+    ASSERT_TRUE(encoded.has_value());
+
+    FixParser parser;
+    FixMessageView view;
+    ASSERT_TRUE(parser.ParseFixMessageView(encoded->view(), view).has_value());
+    EXPECT_EQ(view.getFieldView(FixTag::LastPx), "-0.005");
+    EXPECT_EQ(view.getFieldView(FixTag::LastQty), "1200");
+    EXPECT_EQ(view.getFieldView(FixTag::CumQty), "0");
+    EXPECT_EQ(view.getField<int>(1000), -17);
+    EXPECT_EQ(view.getField<bool>(1001), true);
+
+    //1. Buffer too small for the body
+    std::array<char, FIX_ENCODER_HEADROOM + 40> small;
+    encodeOrder(encoder, small, 1);
+    EXPECT_EQ(encoder.finish().error(), FixError::BufferTooSmall);
+
+    //2. Buffer without headroom
+    encoder.begin(std::span<char>(small.data(), 10), "D", 1, "20240102-09:30:00");
+    EXPECT_EQ(encoder.finish().error(), FixError::BufferTooSmall);
+
+    //3. The encoder is usable again after an error
+    encodeOrder(encoder, buffer, 2);
+    EXPECT_TRUE(encoder.finish().has_value());
+}
+
+TEST(FixEncoderTest, NothingIsWrittenAfterATooSmallBegin) {
+    FixEncoder encoder("FIX.4.4", "A", "B");
+    // On the heap, so a write past its end shows up under ASan
+    std::vector<char> tiny(10, 'x');
+
+    //1. begin() fails, the fields after it are dropped
+    encoder.begin(tiny, "D", 1, "20240102-09:30:00");
+    encoder.addField(FixTag::ClOrdID, "ORD-42");
+    encoder.addField(FixTag::OrderQty, 250);
+    encoder.addField(FixTag::Price, FixDecimal{18725, -2});
+    EXPECT_EQ(encoder.finish().error(), FixError::BufferTooSmall);
+    EXPECT_EQ(std::string(tiny.begin(), tiny.end()), std::string(10, 'x'));
+
+    //2. Same when begin() failed on the message type
+    std::array<char, 512> buffer;
+    encoder.begin(buffer, "", 1, "20240102-09:30:00");
+    encoder.addField(FixTag::Symbol, "IBM");
+    EXPECT_EQ(encoder.finish().error(), FixError::InvalidValue);
+}
+
+TEST(FixEncoderTest, RejectsTagsBelowOne) {
+    FixEncoder encoder("FIX.4.4", "A", "B");
+    // "52=20240102-09:30:00|49=A|56=B|" then room for exactly "2147483647=X|", no trailer.
+    // On the heap, so a write past its end shows up under ASan
+    std::vector<char> tight(FIX_ENCODER_HEADROOM + 31 + 13, 'x');
+
+    //1. The longest positive tag fills the buffer to the last byte
+    encoder.begin(tight, "D", 1, "20240102-09:30:00");
+    encoder.addField(2147483647, 'X');
+    EXPECT_EQ(std::string_view(tight.data() + tight.size() - 13, 13), "2147483647=X\x01");
+    EXPECT_EQ(encoder.finish().error(), FixError::BufferTooSmall);
+
+    //2. A negative tag would be one byte longer, it is rejected before anything is written
+    std::fill(tight.begin(), tight.end(), 'x');
+    encoder.begin(tight, "D", 1, "20240102-09:30:00");
+    encoder.addField(-2147483647 - 1, 'X');
+    EXPECT_EQ(encoder.finish().error(), FixError::InvalidTag);
+    EXPECT_EQ(std::string_view(tight.data() + tight.size() - 13, 13), std::string(13, 'x'));
+
+    //3. So is tag 0
+    encoder.begin(tight, "D", 1, "20240102-09:30:00");
+    encoder.addField(0, "zero");
+    EXPECT_EQ(encoder.finish().error(), FixError::InvalidTag);
+}
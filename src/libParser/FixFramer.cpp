@@ -0,0 +1,162 @@
+#include "FixFramer.h"
+#include "FixChecksum.h"
+#include "Macros.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace {
+    // "10=" + 3 digits + SOH
+    constexpr size_t TRAILER_LENGTH = 7;
+    // "8=" + BeginString + SOH, "FIXT.1.1" is the longest BeginString in use
+    constexpr size_t MAX_BEGIN_STRING_FIELD = 16;
+    constexpr size_t MAX_BODY_LENGTH_DIGITS = 7;
+}
+
+FixFramer::FixFramer(size_t capacity)
+    : _capacity(std::bit_ceil(std::max<size_t>(capacity, 64))),
+      _mask(_capacity - 1)
+{
+    _ring = std::make_unique<char[]>(_capacity);
+    _scratch = std::make_unique<char[]>(_capacity);
+}
+
+std::span<char> FixFramer::writableSpan()
+{
+    size_t offset = _writePos & _mask;
+    size_t free = _capacity - size();
+    return std::span<char>(_ring.get() + offset, std::min(free, _capacity - offset));
+}
+
+void FixFramer::commitWrite(size_t bytes)
+{
+    _writePos += bytes;
+}
+
+size_t FixFramer::write(std::string_view bytes)
+{
+    size_t taken = 0;
+    // At most two copies, before and after the end of the ring
+    while (taken < bytes.size()) {
+        std::span<char> free = writableSpan();
+        if (free.empty())
+            break;
+        size_t n = std::min(free.size(), bytes.size() - taken);
+        std::memcpy(free.data(), bytes.data() + taken, n);
+        commitWrite(n);
+        taken += n;
+    }
+    return taken;
+}
+
+std::string_view FixFramer::contiguous(uint64_t pos, size_t length)
+{
+    size_t offset = pos & _mask;
+    if (LIKELY(offset + length <= _capacity))
+        return std::string_view(_ring.get() + offset, length);
+
+    // Rare: the frame wraps around the end of the ring
+    size_t first = _capacity - offset;
+    std::memcpy(_scratch.get(), _ring.get() + offset, first);
+    std::memcpy(_scratch.get() + first, _ring.get(), length - first);
+    return std::string_view(_scratch.get(), length);
+}
+
+uint32_t FixFramer::byteSum(uint64_t pos, size_t length) const
+{
+    size_t offset = pos & _mask;
+    size_t first = std::min(length, _capacity - offset);
+    uint32_t sum = fixByteSum(std::string_view(_ring.get() + offset, first));
+    if (first < length)
+        sum += fixByteSum(std::string_view(_ring.get(), length - first));
+    return sum;
+}
+
+void FixFramer::skipToNextBeginString()
+{
+    // Drop at least one byte so a bad header is never looked at twice
+    ++_readPos;
+    while (_readPos < _writePos) {
+        if (at(_readPos) == '8' && (_readPos + 1 == _writePos || at(_readPos + 1) == '='))
+            return;
+        ++_readPos;
+    }
+}
+
+std::expected<std::string_view, FixError> FixFramer::nextFrame()
+{
+    const uint64_t start = _readPos;
+    const uint64_t end = _writePos;
+    if (end - start < 2)
+        return std::string_view{};
+
+    if (UNLIKELY(at(start) != '8' || at(start + 1) != '=')) {
+        skipToNextBeginString();
+        return std::unexpected(FixError::MalformedField);
+    }
+
+    //1. End of the BeginString field
+    uint64_t pos = start + 2;
+    while (pos < end && at(pos) != '\x01') {
+        if (UNLIKELY(pos - start > MAX_BEGIN_STRING_FIELD)) {
+            skipToNextBeginString();
+            return std::unexpected(FixError::MalformedField);
+        }
+        ++pos;
+    }
+
+    //2. "9=<digits><SOH>"
+    if (pos + 3 >= end)
+        return std::string_view{};
+    if (UNLIKELY(at(pos + 1) != '9' || at(pos + 2) != '=')) {
+        skipToNextBeginString();
+        return std::unexpected(FixError::InvalidBodyLength);
+    }
+    pos += 3;
+    size_t bodyLength = 0;
+    size_t digits = 0;
+    for (; pos < end && at(pos) != '\x01'; ++pos, ++digits) {
+        unsigned d = static_cast<unsigned>(at(pos) - '0');
+        if (UNLIKELY(d > 9 || digits == MAX_BODY_LENGTH_DIGITS)) {
+            skipToNextBeginString();
+            return std::unexpected(FixError::InvalidBodyLength);
+        }
+        bodyLength = bodyLength * 10 + d;
+    }
+    if (pos >= end)
+        return std::string_view{};
+    if (UNLIKELY(digits == 0)) {
+        skipToNextBeginString();
+        return std::unexpected(FixError::InvalidBodyLength);
+    }
+
+    //3. The whole frame has to be in the ring
+    const uint64_t trailer = pos + 1 + bodyLength;
+    const size_t frameLength = static_cast<size_t>(trailer - start) + TRAILER_LENGTH;
+    if (UNLIKELY(frameLength > _capacity)) {
+        skipToNextBeginString();
+        return std::unexpected(FixError::FrameTooLarge);
+    }
+    if (end - start < frameLength)
+        return std::string_view{};
+
+    //4. BodyLength has to land exactly on "10=ddd<SOH>"
+    unsigned checksum = 0;
+    bool trailerOk = at(trailer) == '1' && at(trailer + 1) == '0' && at(trailer + 2) == '='
+                     && at(trailer + 6) == '\x01' && at(trailer - 1) == '\x01';
+    for (size_t i = 3; trailerOk && i < 6; ++i) {
+        unsigned d = static_cast<unsigned>(at(trailer + i) - '0');
+        trailerOk = d <= 9;
+        checksum = checksum * 10 + d;
+    }
+    if (UNLIKELY(!trailerOk)) {
+        skipToNextBeginString();
+        return std::unexpected(FixError::InvalidBodyLength);
+    }
+
+    _readPos = start + frameLength;
+    if (UNLIKELY((byteSum(start, static_cast<size_t>(trailer - start)) & 0xFF) != checksum))
+        return std::unexpected(FixError::ChecksumMismatch);
+
+    return contiguous(start, frameLength);
+}
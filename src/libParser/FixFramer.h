@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string_view>
+#include "Errors.h"
+
+static const size_t FIX_FRAMER_DEFAULT_CAPACITY = 1 << 20;  // 1 MB
+
+/*
+Cuts a TCP byte stream into complete FIX messages.
+Bytes go into a ring buffer, either by recv() straight into writableSpan() followed by
+commitWrite(), or by copying with write(). nextFrame() finds message boundaries from
+"8=..|9=<BodyLength>|", checks the "10=" trailer and its CheckSum and hands out the
+frame as a view into the ring. Only a frame that wraps around the end of the ring is
+copied, into a scratch buffer of the same size.
+
+A frame returned by nextFrame() stays valid until the next nextFrame(), write() or
+commitWrite() call.
+*/
+class FixFramer {
+    std::unique_ptr<char[]> _ring;
+    std::unique_ptr<char[]> _scratch;   // linearizes frames that wrap around the ring
+    size_t _capacity;                   // power of two
+    size_t _mask;
+    uint64_t _readPos = 0;              // both positions only ever grow
+    uint64_t _writePos = 0;
+
+    char at(uint64_t pos) const { return _ring[pos & _mask]; }
+    std::string_view contiguous(uint64_t pos, size_t length);
+    uint32_t byteSum(uint64_t pos, size_t length) const;
+    void skipToNextBeginString();
+
+public:
+    explicit FixFramer(size_t capacity = FIX_FRAMER_DEFAULT_CAPACITY);
+
+    FixFramer(const FixFramer&) = delete;
+    FixFramer& operator=(const FixFramer&) = delete;
+
+    // Free space at the write position, contiguous so it can be passed to recv().
+    std::span<char> writableSpan();
+    void commitWrite(size_t bytes);
+
+    // Copies as much of bytes as fits, returns the number of bytes taken.
+    size_t write(std::string_view bytes);
+
+    /*
+    Next complete message, or an empty view when more bytes are needed.
+    On a malformed header the framer skips to the next "8=" and reports MalformedField or
+    InvalidBodyLength; a frame with a wrong CheckSum is dropped and reported as
+    ChecksumMismatch. Either way the next call carries on with the following bytes.
+    */
+    std::expected<std::string_view, FixError> nextFrame();
+
+    size_t size() const { return static_cast<size_t>(_writePos - _readPos); }
+    size_t capacity() const { return _capacity; }
+};
@@ -1,22 +1,175 @@
 #include "FixMessage.h"
+#include "FixMessageView.h"
 #include "FixParser.h"
+#include "Macros.h"
+#include "FixChecksum.h"
+#include "FixGroups.h"
+#include "FixValueDecoder.h"
 
-FixMessage FixParser::ParseFixMessage(const std::string& raw, char delimiter) 
+namespace {
+    // Hand rolled tag decoding: no allocation, no exceptions, no locale.
+    bool parseTag(std::string_view digits, int& tag)
+    {
+        if (UNLIKELY(digits.empty() || digits.size() > 9))
+            return false;
+
+        int value = 0;
+        for (char c : digits) {
+            unsigned d = static_cast<unsigned>(c - '0');
+            if (UNLIKELY(d > 9))
+                return false;
+            value = value * 10 + static_cast<int>(d);
+        }
+        tag = value;
+        return value > 0;
+    }
+}
+
+static_assert(FixParserLike<FixParser>);
+
+template<typename Sink>
+std::expected<void, FixError> FixParser::parseFields(std::string_view raw, Sink& out, char delimiter)
 {
-    FixMessage msg;
-    size_t start = 0;
-    size_t end;
-
-    while ((end = raw.find(delimiter, start)) != std::string::npos) {
-        std::string token = raw.substr(start, end - start);
-        size_t sep = token.find('=');
-        if (sep != std::string::npos) {
-            int tag = std::stoi(token.substr(0, sep));
-            std::string value = token.substr(sep + 1);
-            msg.addField(tag, value);
+    out.clear();
+    if (UNLIKELY(raw.empty()))
+        return std::unexpected(FixError::EmptyMessage);
+
+    // Every field needs at least "t=<SOH>", which bounds the field count of well formed input
+    size_t maxFields = raw.size() / 3 + 1;
+    if (UNLIKELY(_offsets.size() < maxFields))
+        _offsets.resize(maxFields);
+
+    const bool validate = _options.validateBodyLength || _options.validateChecksum;
+    uint32_t byteSum = 0;
+    size_t bodyStart = 0;          // first byte after "9=..<SOH>"
+    size_t bodyLength = 0;
+    size_t trailerStart = 0;       // first byte of "10="
+    std::string_view checksum;
+    size_t fieldIndex = 0;
+
+    // Repeating group being walked, views only: FixMessage keeps every field flat
+    constexpr bool GROUP_AWARE = std::same_as<Sink, FixMessageView>;
+    const FixGroupDef* group = nullptr;
+    uint32_t instancesLeft = 0;     // instances declared by the count and not started yet
+    std::string_view instanceTag;   // tag bytes of the first field of every instance
+
+    size_t base = 0;
+    while (base < raw.size()) {
+        std::string_view rest = raw.substr(base);
+        auto tokens = TokenizeFix(rest, _offsets, delimiter, _options.validateChecksum);
+        if (UNLIKELY(tokens.fieldCount == 0))
+            return std::unexpected(FixError::MalformedField);
+        byteSum += tokens.byteSum;
+
+        for (size_t i = 0; i < tokens.fieldCount; ++i, ++fieldIndex) {
+            const FixFieldOffset& field = _offsets[i];
+            if (UNLIKELY(field.equals == field.end))
+                return std::unexpected(FixError::MalformedField);
+
+            std::string_view tagText = rest.substr(field.tagStart, field.equals - field.tagStart);
+            std::string_view value = rest.substr(field.equals + 1, field.end - field.equals - 1);
+            int tag = 0;    // stays 0 until parsed
+
+            if constexpr (GROUP_AWARE) {
+                if (group) {
+                    const char* fieldStart = rest.data() + field.tagStart;
+                    // Instances are told apart by comparing tag bytes, their fields are not decoded
+                    if (instancesLeft > 0 && tagText == instanceTag) {
+                        out.addGroupInstance(fieldStart);
+                        --instancesLeft;
+                        continue;
+                    }
+                    // Inside an earlier instance: not stored on their own, but checked like any field
+                    if (instancesLeft > 0 && !instanceTag.empty()) {
+                        if (UNLIKELY(!parseTag(tagText, tag)))
+                            return std::unexpected(FixError::InvalidTag);
+                        continue;
+                    }
+
+                    // First field of the group, or inside the last instance where the group may end
+                    if (UNLIKELY(!parseTag(tagText, tag)))
+                        return std::unexpected(FixError::InvalidTag);
+                    if (instanceTag.empty() && group->isMember(tag)) {
+                        instanceTag = tagText;
+                        out.addGroupInstance(fieldStart);
+                        --instancesLeft;
+                        continue;
+                    }
+                    if (UNLIKELY(tagText == instanceTag || instancesLeft > 0))
+                        return std::unexpected(FixError::InvalidGroup);
+                    if (group->isMember(tag))
+                        continue;
+                    out.endGroup(fieldStart);
+                    group = nullptr;
+                }
+            }
+
+            if (tag == 0 && UNLIKELY(!parseTag(tagText, tag)))
+                return std::unexpected(FixError::InvalidTag);
+            out.addField(tag, value);
+
+            if constexpr (GROUP_AWARE) {
+                if (const FixGroupDef* def = FixGroups::find(tag)) {
+                    if (UNLIKELY(!decodeFixInteger(value, instancesLeft)))
+                        return std::unexpected(FixError::InvalidGroup);
+                    out.beginGroup(delimiter);
+                    instanceTag = {};
+                    group = instancesLeft > 0 ? def : nullptr;
+                }
+            }
+
+            if (validate) {
+                // BodyLength is always the second field, CheckSum always the last one
+                if (fieldIndex == 1 && tag == 9) {
+                    if (UNLIKELY(!decodeFixInteger(value, bodyLength)))
+                        return std::unexpected(FixError::InvalidBodyLength);
+                    bodyStart = base + field.end + 1;
+                } else if (tag == 10) {
+                    trailerStart = base + field.tagStart;
+                    checksum = value;
+                }
+            }
+        }
+        base += tokens.consumed;
+    }
+
+    if constexpr (GROUP_AWARE) {
+        if (group) {
+            if (UNLIKELY(instancesLeft > 0))
+                return std::unexpected(FixError::InvalidGroup);
+            out.endGroup(raw.data() + base);
+        }
+    }
+
+    if (validate) {
+        // CheckSum has to be the very last field
+        if (UNLIKELY(bodyStart == 0 || trailerStart == 0 || trailerStart + 4 + checksum.size() != raw.size()))
+            return std::unexpected(FixError::InvalidBodyLength);
+        if (_options.validateBodyLength && UNLIKELY(bodyStart + bodyLength != trailerStart))
+            return std::unexpected(FixError::InvalidBodyLength);
+        if (_options.validateChecksum) {
+            // The tokenizer summed everything, take the trailer back out
+            uint32_t expected = (byteSum - fixByteSum(raw.substr(trailerStart))) & 0xFF;
+            uint32_t received = 0;
+            if (UNLIKELY(checksum.size() != 3 || !decodeFixInteger(checksum, received) || received != expected))
+                return std::unexpected(FixError::ChecksumMismatch);
         }
-        start = end + 1;
     }
 
-    return msg;
-}
\ No newline at end of file
+    return {};
+}
+
+std::expected<void, FixError> FixParser::parseInto(std::string_view raw, FixMessage& msg)
+{
+    return parseFields(raw, msg, '\x01');
+}
+
+std::expected<void, FixError> FixParser::parse(std::string_view raw, FixMessage& msg)
+{
+    return parseInto(raw, msg);
+}
+
+std::expected<void, FixError> FixParser::ParseFixMessageView(std::string_view raw, FixMessageView& view, char delimiter)
+{
+    return parseFields(raw, view, delimiter);
+}
@@ -1,9 +1,52 @@
-#include <string>
+#pragma once
+#include <string_view>
+#include <expected>
+#include <vector>
 #include "IFixParser.h"
+#include "Errors.h"
+#include "FixTokenizer.h"
 
 class FixMessage;
+class FixMessageView;
 
-class FixParser : public IFixParser
+// Per session switches, trusted internal links can turn validation off entirely
+struct FixParserOptions {
+    bool validateBodyLength = true;     // 9= must end exactly where 10= starts
+    bool validateChecksum = true;       // 10= must match the byte sum, computed in the tokenizer pass
+};
+
+/*
+Tokenizes with the SIMD kernels of FixTokenizer and decodes tags by hand: no allocation
+once warmed up. Bad input is reported as a FixError, never thrown; only growing the
+scratch space or the message can throw std::bad_alloc. final, so calls through a FixParser are never virtual;
+parseInto is the entry point for code templated on FixParserLike.
+*/
+class FixParser final : public IFixParser
 {
-    FixMessage ParseFixMessage(const std::string& raw, char delimiter = '\x01');
-};
\ No newline at end of file
+public:
+    explicit FixParser(FixParserOptions options = {}) : _options(options) {}
+
+    void setOptions(FixParserOptions options) { _options = options; }
+    FixParserOptions options() const { return _options; }
+
+    // Parses raw into msg, which is cleared first and keeps its buffers across calls.
+    std::expected<void, FixError> parseInto(std::string_view raw, FixMessage& msg);
+
+    using IFixParser::parse;
+    std::expected<void, FixError> parse(std::string_view raw, FixMessage& msg) override;
+
+    // Zero-copy parse: fills the view with (tag, value) pairs pointing into raw.
+    // Nothing is allocated once the view's field index has warmed up.
+    // BodyLength and CheckSum are checked according to options(): InvalidBodyLength, ChecksumMismatch.
+    // Repeating groups from FixGroups.h are indexed, not flattened, see FixMessageView::group().
+    std::expected<void, FixError> ParseFixMessageView(std::string_view raw, FixMessageView& view, char delimiter = '\x01');
+
+private:
+    FixParserOptions _options;
+    // Scratch space for the tokenizer, grown on demand and reused across messages
+    std::vector<FixFieldOffset> _offsets;
+
+    // Shared by FixMessage and FixMessageView, both only need clear() and addField()
+    template<typename Sink>
+    std::expected<void, FixError> parseFields(std::string_view raw, Sink& out, char delimiter);
+};
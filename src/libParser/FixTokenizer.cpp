@@ -0,0 +1,240 @@
+#include "FixTokenizer.h"
+#include "Macros.h"
+#include "FixChecksum.h"
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FIX_TOKENIZER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    constexpr uint32_t NO_EQUALS = UINT32_MAX;
+
+    using KernelFn = FixTokenizeResult (*)(std::string_view, std::span<FixFieldOffset>, char);
+
+    struct TokenizerState {
+        std::span<FixFieldOffset> out;
+        size_t count = 0;
+        uint32_t fieldStart = 0;
+        uint32_t equals = NO_EQUALS;
+        uint32_t byteSum = 0;   // of every byte scanned so far, [0, scannedEnd)
+
+        // The scan may have summed bytes past the last delimiter, take them back out
+        FixTokenizeResult result(std::string_view raw, size_t scannedEnd) const {
+            return {count, fieldStart, byteSum - fixByteSum(raw.substr(fieldStart, scannedEnd - fieldStart))};
+        }
+        FixTokenizeResult result() const { return {count, fieldStart, 0}; }
+    };
+
+    /*
+    Consumes the delimiter and '=' bitmasks of one block starting at base.
+    Bit i of each mask stands for byte base + i. Every delimiter closes a field;
+    the first '=' seen since the field started is its separator.
+    Returns false once out is full.
+    */
+    inline bool processMasks(TokenizerState& st, uint64_t delims, uint64_t equals, uint32_t base)
+    {
+        while (delims) {
+            uint32_t bit = __builtin_ctzll(delims);
+            uint32_t pos = base + bit;
+
+            if (st.equals == NO_EQUALS) {
+                uint64_t before = equals & ((1ULL << bit) - 1);
+                if (before)
+                    st.equals = base + __builtin_ctzll(before);
+            }
+
+            if (UNLIKELY(st.count == st.out.size()))
+                return false;
+            st.out[st.count++] = FixFieldOffset{st.fieldStart, st.equals == NO_EQUALS ? pos : st.equals, pos};
+            st.fieldStart = pos + 1;
+            st.equals = NO_EQUALS;
+
+            // '=' up to this delimiter belonged to the field just closed
+            equals &= ~((2ULL << bit) - 1);
+            delims &= delims - 1;
+        }
+
+        if (st.equals == NO_EQUALS && equals)
+            st.equals = base + __builtin_ctzll(equals);
+        return true;
+    }
+
+    // memchr based scan, used on its own where no vector kernel exists and for the tail of the vector kernels
+    void scanScalar(TokenizerState& st, std::string_view raw, size_t from, char delimiter)
+    {
+        const char* base = raw.data();
+        const char* cursor = base + from;
+        const char* last = base + raw.size();
+
+        while (cursor < last) {
+            auto* end = static_cast<const char*>(std::memchr(cursor, delimiter, last - cursor));
+            if (end == nullptr) {
+                if (st.equals == NO_EQUALS) {
+                    auto* eq = static_cast<const char*>(std::memchr(cursor, '=', last - cursor));
+                    if (eq != nullptr)
+                        st.equals = static_cast<uint32_t>(eq - base);
+                }
+                break;
+            }
+            if (UNLIKELY(st.count == st.out.size()))
+                break;
+
+            uint32_t pos = static_cast<uint32_t>(end - base);
+            if (st.equals == NO_EQUALS) {
+                auto* eq = static_cast<const char*>(std::memchr(cursor, '=', end - cursor));
+                st.equals = eq != nullptr ? static_cast<uint32_t>(eq - base) : pos;
+            }
+            st.out[st.count++] = FixFieldOffset{st.fieldStart, st.equals, pos};
+            st.fieldStart = pos + 1;
+            st.equals = NO_EQUALS;
+            cursor = end + 1;
+        }
+    }
+
+    template<bool WithSum>
+    FixTokenizeResult finishScalar(TokenizerState& st, std::string_view raw, size_t from, char delimiter)
+    {
+        scanScalar(st, raw, from, delimiter);
+        if constexpr (WithSum) {
+            st.byteSum += fixByteSum(raw.substr(from));
+            return st.result(raw, raw.size());
+        }
+        return st.result();
+    }
+
+    template<bool WithSum>
+    FixTokenizeResult tokenizeScalar(std::string_view raw, std::span<FixFieldOffset> out, char delimiter)
+    {
+        TokenizerState st{out};
+        return finishScalar<WithSum>(st, raw, 0, delimiter);
+    }
+
+#ifdef FIX_TOKENIZER_X86
+    // Lambdas do not inherit the target attribute, hence the free functions
+    __attribute__((target("sse2")))
+    uint32_t totalSum(__m128i sums)
+    {
+        return static_cast<uint32_t>(_mm_cvtsi128_si64(sums) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+    }
+
+    __attribute__((target("avx2")))
+    uint32_t totalSum(__m256i sums)
+    {
+        return totalSum(_mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1)));
+    }
+
+    template<bool WithSum>
+    __attribute__((target("sse2")))
+    FixTokenizeResult tokenizeSse2(std::string_view raw, std::span<FixFieldOffset> out, char delimiter)
+    {
+        TokenizerState st{out};
+        const __m128i delim = _mm_set1_epi8(delimiter);
+        const __m128i eq = _mm_set1_epi8('=');
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sums = _mm_setzero_si128();   // two 64 bit lanes of byte sums
+
+        size_t i = 0;
+        for (; i + 16 <= raw.size(); i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw.data() + i));
+            if constexpr (WithSum)
+                sums = _mm_add_epi64(sums, _mm_sad_epu8(block, zero));
+            uint64_t delims = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, delim)));
+            uint64_t equals = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, eq)));
+            if (UNLIKELY(!processMasks(st, delims, equals, static_cast<uint32_t>(i)))) {
+                if constexpr (WithSum) {
+                    st.byteSum = totalSum(sums);
+                    return st.result(raw, i + 16);
+                }
+                return st.result();
+            }
+        }
+        if constexpr (WithSum)
+            st.byteSum = totalSum(sums);
+        return finishScalar<WithSum>(st, raw, i, delimiter);
+    }
+
+    template<bool WithSum>
+    __attribute__((target("avx2")))
+    FixTokenizeResult tokenizeAvx2(std::string_view raw, std::span<FixFieldOffset> out, char delimiter)
+    {
+        TokenizerState st{out};
+        const __m256i delim = _mm256_set1_epi8(delimiter);
+        const __m256i eq = _mm256_set1_epi8('=');
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i sums = _mm256_setzero_si256();  // four 64 bit lanes of byte sums
+
+        size_t i = 0;
+        for (; i + 32 <= raw.size(); i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw.data() + i));
+            if constexpr (WithSum)
+                sums = _mm256_add_epi64(sums, _mm256_sad_epu8(block, zero));
+            uint64_t delims = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, delim)));
+            uint64_t equals = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, eq)));
+            if (UNLIKELY(!processMasks(st, delims, equals, static_cast<uint32_t>(i)))) {
+                if constexpr (WithSum) {
+                    st.byteSum = totalSum(sums);
+                    return st.result(raw, i + 32);
+                }
+                return st.result();
+            }
+        }
+        if constexpr (WithSum)
+            st.byteSum = totalSum(sums);
+        return finishScalar<WithSum>(st, raw, i, delimiter);
+    }
+#endif
+
+    FixTokenizerKernel detectKernel()
+    {
+#ifdef FIX_TOKENIZER_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return FixTokenizerKernel::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return FixTokenizerKernel::SSE2;
+#endif
+        return FixTokenizerKernel::Scalar;
+    }
+
+    KernelFn kernelFor(FixTokenizerKernel kernel, bool withByteSum)
+    {
+#ifdef FIX_TOKENIZER_X86
+        // Never hand out a kernel the CPU cannot execute
+        if (kernel > ActiveTokenizerKernel())
+            kernel = ActiveTokenizerKernel();
+        switch (kernel) {
+            case FixTokenizerKernel::AVX2:
+                return withByteSum ? tokenizeAvx2<true> : tokenizeAvx2<false>;
+            case FixTokenizerKernel::SSE2:
+                return withByteSum ? tokenizeSse2<true> : tokenizeSse2<false>;
+            default:
+                break;
+        }
+#endif
+        (void)kernel;
+        return withByteSum ? tokenizeScalar<true> : tokenizeScalar<false>;
+    }
+}
+
+FixTokenizerKernel ActiveTokenizerKernel()
+{
+    static const FixTokenizerKernel kernel = detectKernel();
+    return kernel;
+}
+
+FixTokenizeResult TokenizeFix(std::string_view raw, std::span<FixFieldOffset> out, char delimiter, bool withByteSum)
+{
+    static const KernelFn kernels[2] = {kernelFor(ActiveTokenizerKernel(), false), kernelFor(ActiveTokenizerKernel(), true)};
+    assert(raw.size() < NO_EQUALS && "FixTokenizer: offsets are 32 bit");
+    return kernels[withByteSum](raw, out, delimiter);
+}
+
+FixTokenizeResult TokenizeFixWith(FixTokenizerKernel kernel, std::string_view raw, std::span<FixFieldOffset> out,
+                                  char delimiter, bool withByteSum)
+{
+    assert(raw.size() < NO_EQUALS && "FixTokenizer: offsets are 32 bit");
+    return kernelFor(kernel, withByteSum)(raw, out, delimiter);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/*
+Field boundaries found by the tokenizer, as byte offsets into the scanned buffer.
+For "35=D<SOH>" starting at offset 10: tagStart = 10, equals = 12, end = 14.
+A field without any '=' has equals == end.
+*/
+struct FixFieldOffset {
+    uint32_t tagStart;
+    uint32_t equals;
+    uint32_t end;
+};
+
+struct FixTokenizeResult {
+    size_t fieldCount = 0;  // number of offsets written
+    size_t consumed = 0;    // bytes up to and including the last delimiter found
+    uint32_t byteSum = 0;   // sum of the bytes in [0, consumed), only when requested
+};
+
+enum class FixTokenizerKernel
+{
+    Scalar,
+    SSE2,   // 16 bytes per step
+    AVX2    // 32 bytes per step
+};
+
+/*
+Finds every delimiter and the first '=' of every field in a single pass and writes
+one FixFieldOffset per complete field. Stops early when out is full, in which case
+consumed < raw.size() and the caller can resume from raw.substr(consumed).
+Bytes after the last delimiter are not reported as a field.
+With withByteSum the bytes are also summed in the same pass (SAD instructions on the
+vector kernels), which is what CheckSum validation needs.
+*/
+FixTokenizeResult TokenizeFix(std::string_view raw, std::span<FixFieldOffset> out, char delimiter = '\x01', bool withByteSum = false);
+
+// Same as TokenizeFix but forces a kernel. Kernels the CPU cannot run fall back to Scalar.
+FixTokenizeResult TokenizeFixWith(FixTokenizerKernel kernel, std::string_view raw, std::span<FixFieldOffset> out,
+                                  char delimiter = '\x01', bool withByteSum = false);
+
+// Kernel picked by the runtime CPU dispatch.
+FixTokenizerKernel ActiveTokenizerKernel();
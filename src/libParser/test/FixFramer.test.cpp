@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "FixFramer.h"
+#include "FixTestMessages.h"
+
+TEST(FixFramerTest, SplitsChunksIntoFrames) {
+    FixFramer framer(4096);
+    std::string first = makeFix("35=D|49=A|56=B|34=1|11=ORD1|");
+    std::string second = makeFix("35=0|49=A|56=B|34=2|");
+    std::string stream = first + second;
+
+    //1. Byte by byte: no frame until the last byte of each message arrived
+    std::vector<std::string> frames;
+    for (char c : stream) {
+        ASSERT_EQ(framer.write(std::string_view(&c, 1)), 1);
+        auto frame = framer.nextFrame();
+        ASSERT_TRUE(frame.has_value());
+        if (!frame->empty())
+            frames.emplace_back(*frame);
+    }
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0], first);
+    EXPECT_EQ(frames[1], second);
+    EXPECT_EQ(framer.size(), 0);
+
+    //2. Many messages in one chunk
+    std::string burst;
+    for (int i = 0; i < 10; ++i) burst += makeFix("35=0|34=" + std::to_string(i) + "|");
+    ASSERT_EQ(framer.write(burst), burst.size());
+    int count = 0;
+    for (auto frame = framer.nextFrame(); frame.has_value() && !frame->empty(); frame = framer.nextFrame())
+        ++count;
+    EXPECT_EQ(count, 10);
+}
+
+TEST(FixFramerTest, FramesWrapAroundTheRing) {
+    FixFramer framer(256);
+    std::string msg = makeFix("35=D|49=SENDER|56=TARGET|11=WRAPPING-ORDER|55=IBM|");
+
+    // Enough round trips for frames to start at every offset of the ring
+    for (int i = 0; i < 200; ++i) {
+        std::span<char> free = framer.writableSpan();
+        size_t n = std::min(free.size(), msg.size());
+        std::copy_n(msg.data(), n, free.data());
+        framer.commitWrite(n);
+        ASSERT_EQ(framer.write(std::string_view(msg).substr(n)), msg.size() - n);
+
+        auto frame = framer.nextFrame();
+        ASSERT_TRUE(frame.has_value());
+        ASSERT_EQ(*frame, msg);
+    }
+}
+
+TEST(FixFramerTest, RejectsBadInput) {
+    FixFramer framer(4096);
+    std::string good = makeFix("35=0|34=1|");
+
+    //1. Garbage before a message is skipped
+    framer.write("garbage" + good);
+    EXPECT_EQ(framer.nextFrame().error(), FixError::MalformedField);
+    EXPECT_EQ(framer.nextFrame(), good);
+
+    //2. Wrong CheckSum drops the frame
+    std::string badChecksum = good;
+    badChecksum[badChecksum.size() - 2] = badChecksum[badChecksum.size() - 2] == '0' ? '1' : '0';
+    framer.write(badChecksum + good);
+    EXPECT_EQ(framer.nextFrame().error(), FixError::ChecksumMismatch);
+    EXPECT_EQ(framer.nextFrame(), good);
+
+    //3. BodyLength that does not end on the trailer
+    std::string badLength = good;
+    badLength.replace(badLength.find("9=") + 2, 2, "11");
+    framer.write(badLength + good);
+    EXPECT_EQ(framer.nextFrame().error(), FixError::InvalidBodyLength);
+    EXPECT_EQ(framer.nextFrame(), good);
+
+    //4. A message larger than the ring
+    FixFramer small(64);
+    small.write(makeFix("35=0|58=" + std::string(100, 'x') + "|").substr(0, 64));
+    EXPECT_EQ(small.nextFrame().error(), FixError::FrameTooLarge);
+}
@@ -0,0 +1,289 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "FixParser.h"
+#include "FixMessage.h"
+#include "FixMessageView.h"
+#include "FixDictionary.h"
+#include "FixEncoder.h"
+#include "FixTags.h"
+#include "MemoryResource.hpp"
+
+/*
+Parser throughput over a generated corpus. Every message is produced by FixEncoder,
+so BodyLength and CheckSum are real and the parser validates them as it would live.
+Besides time per iteration each benchmark reports:
+    time/msg - time per message
+    items/s  - messages per second
+    bytes/s  - wire bytes per second
+*/
+
+namespace {
+    const char* SENDING_TIME = "20240102-09:30:00.123456";
+
+    enum class Corpus { Heartbeat, NewOrderSingle, ExecutionReport, MarketData, Mixed };
+
+    std::string toString(const FixEncodedMessage& msg) { return std::string(msg.view()); }
+
+    std::string heartbeat(FixEncoder& encoder, std::vector<char>& buffer, uint64_t seqNum) {
+        encoder.begin(buffer, "0", seqNum, SENDING_TIME);
+        return toString(*encoder.finish());
+    }
+
+    std::string newOrderSingle(FixEncoder& encoder, std::vector<char>& buffer, uint64_t seqNum) {
+        encoder.begin(buffer, "D", seqNum, SENDING_TIME);
+        encoder.addField(FixTag::ClOrdID, "ORD-" + std::to_string(1000000 + seqNum));
+        encoder.addField(1, "ACCOUNT-7");
+        encoder.addField(21, '1');
+        encoder.addField(FixTag::Symbol, "MSFT");
+        encoder.addField(FixTag::Side, seqNum % 2 ? '1' : '2');
+        encoder.addField(60, SENDING_TIME);
+        encoder.addField(FixTag::OrderQty, 100 * (seqNum % 10 + 1));
+        encoder.addField(40, '2');
+        encoder.addField(FixTag::Price, FixDecimal{static_cast<int64_t>(41200 + seqNum % 150), -2});
+        encoder.addField(59, '0');
+        return toString(*encoder.finish());
+    }
+
+    std::string executionReport(FixEncoder& encoder, std::vector<char>& buffer, uint64_t seqNum) {
+        encoder.begin(buffer, "8", seqNum, SENDING_TIME);
+        encoder.addField(37, "EX-" + std::to_string(7000000 + seqNum));
+        encoder.addField(FixTag::ClOrdID, "ORD-" + std::to_string(1000000 + seqNum));
+        encoder.addField(17, "EXEC-" + std::to_string(9000000 + seqNum));
+        encoder.addField(150, 'F');
+        encoder.addField(39, '1');
+        encoder.addField(FixTag::Symbol, "MSFT");
+        encoder.addField(FixTag::Side, '1');
+        encoder.addField(FixTag::OrderQty, 500);
+        encoder.addField(FixTag::Price, FixDecimal{41275, -2});
+        encoder.addField(FixTag::LastPx, FixDecimal{41270, -2});
+        encoder.addField(FixTag::LastQty, 200);
+        encoder.addField(FixTag::LeavesQty, 300);
+        encoder.addField(FixTag::CumQty, 200);
+        encoder.addField(6, FixDecimal{41270, -2});
+        encoder.addField(60, SENDING_TIME);
+        return toString(*encoder.finish());
+    }
+
+    // MarketDataIncrementalRefresh, one NoMDEntries group of `entries` price levels
+    std::string marketData(FixEncoder& encoder, std::vector<char>& buffer, uint64_t seqNum, int entries) {
+        encoder.begin(buffer, "X", seqNum, SENDING_TIME);
+        encoder.addField(262, "MDREQ-1");
+        encoder.addField(268, entries);
+        for (int i = 0; i < entries; ++i) {
+            encoder.addField(279, i % 3 == 0 ? '0' : '1');
+            encoder.addField(269, i % 2 ? '1' : '0');
+            encoder.addField(FixTag::Symbol, "MSFT");
+            encoder.addField(270, FixDecimal{41200 + i, -2});
+            encoder.addField(271, 100 * (i % 7 + 1));
+        }
+        return toString(*encoder.finish());
+    }
+
+    // 64 messages of one kind, or a session like mix for Corpus::Mixed
+    std::vector<std::string> makeCorpus(Corpus kind, int mdEntries = 20) {
+        FixEncoder encoder("FIX.4.4", "BROKER_COMP", "CLIENT_COMP");
+        std::vector<char> buffer(1 << 16);
+        std::vector<std::string> corpus;
+        for (uint64_t seqNum = 1; seqNum <= 64; ++seqNum) {
+            Corpus current = kind;
+            if (kind == Corpus::Mixed) {
+                // Mostly market data, some order flow, the odd heartbeat
+                static const Corpus MIX[] = {Corpus::MarketData, Corpus::MarketData, Corpus::ExecutionReport,
+                                             Corpus::MarketData, Corpus::NewOrderSingle, Corpus::MarketData,
+                                             Corpus::ExecutionReport, Corpus::Heartbeat};
+                current = MIX[seqNum % std::size(MIX)];
+            }
+            switch (current) {
+            case Corpus::Heartbeat: corpus.push_back(heartbeat(encoder, buffer, seqNum)); break;
+            case Corpus::NewOrderSingle: corpus.push_back(newOrderSingle(encoder, buffer, seqNum)); break;
+            case Corpus::ExecutionReport: corpus.push_back(executionReport(encoder, buffer, seqNum)); break;
+            default: corpus.push_back(marketData(encoder, buffer, seqNum, mdEntries)); break;
+            }
+        }
+        return corpus;
+    }
+
+    size_t corpusBytes(const std::vector<std::string>& corpus) {
+        size_t bytes = 0;
+        for (const auto& msg : corpus)
+            bytes += msg.size();
+        return bytes;
+    }
+
+    void setCounters(benchmark::State& state, const std::vector<std::string>& corpus) {
+        state.SetItemsProcessed(state.iterations() * corpus.size());
+        state.SetBytesProcessed(state.iterations() * corpusBytes(corpus));
+        // Inverted rate of messages per second, printed with its SI prefix (e.g. "95.2ns")
+        state.counters["time/msg"] = benchmark::Counter(static_cast<double>(corpus.size()),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    // corpus: 0 Heartbeat, 1 NewOrderSingle, 2 ExecutionReport, 3 MarketData, 4 Mixed
+    void addCorpusArgs(benchmark::internal::Benchmark* bench) {
+        bench->ArgNames({"corpus", "mdEntries"});
+        bench->Args({static_cast<int>(Corpus::Heartbeat), 0});
+        bench->Args({static_cast<int>(Corpus::NewOrderSingle), 0});
+        bench->Args({static_cast<int>(Corpus::ExecutionReport), 0});
+        bench->Args({static_cast<int>(Corpus::MarketData), 20});
+        bench->Args({static_cast<int>(Corpus::MarketData), 200});
+        bench->Args({static_cast<int>(Corpus::Mixed), 20});
+    }
+
+    std::vector<std::string> corpusFor(const benchmark::State& state) {
+        return makeCorpus(static_cast<Corpus>(state.range(0)), static_cast<int>(state.range(1)));
+    }
+}
+
+static void BM_ParseView(benchmark::State& state) {
+    auto corpus = corpusFor(state);
+    FixParser parser;
+    FixMessageView view;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            benchmark::DoNotOptimize(parser.ParseFixMessageView(raw, view));
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK(BM_ParseView)->Apply(addCorpusArgs);
+
+static void BM_ParseMessage(benchmark::State& state) {
+    auto corpus = corpusFor(state);
+    FixParser parser;
+    FixMessage msg;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            benchmark::DoNotOptimize(parser.parseInto(raw, msg));
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK(BM_ParseMessage)->Apply(addCorpusArgs);
+
+// Same as BM_ParseMessage with BodyLength and CheckSum validation off, shows what validation costs
+static void BM_ParseMessageUnvalidated(benchmark::State& state) {
+    auto corpus = corpusFor(state);
+    FixParser parser(FixParserOptions{false, false});
+    FixMessage msg;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            benchmark::DoNotOptimize(parser.parseInto(raw, msg));
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK(BM_ParseMessageUnvalidated)->Apply(addCorpusArgs);
+
+// A fresh FixMessage per inbound message, as when messages are kept past the next parse:
+// from the global heap, or from a session arena reset before every message
+template<bool UseArena>
+static void BM_ParseFreshMessage(benchmark::State& state) {
+    auto corpus = corpusFor(state);
+    FixParser parser;
+    MessageArena arena;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            arena.reset();
+            FixMessage msg(UseArena ? static_cast<std::pmr::memory_resource*>(&arena) : std::pmr::get_default_resource());
+            benchmark::DoNotOptimize(parser.parseInto(raw, msg));
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK_TEMPLATE(BM_ParseFreshMessage, false)->Apply(addCorpusArgs);
+BENCHMARK_TEMPLATE(BM_ParseFreshMessage, true)->Apply(addCorpusArgs);
+
+// Top of book out of large market data messages: the view indexes the NoMDEntries instances
+// and decodes only the ones read, the owning message copies every entry field
+static void BM_ParseMarketDataTopOfBook(benchmark::State& state) {
+    auto corpus = makeCorpus(Corpus::MarketData, static_cast<int>(state.range(0)));
+    FixParser parser;
+    FixMessageView view;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            if (!parser.ParseFixMessageView(raw, view)) {
+                state.SkipWithError("corpus message rejected");
+                return;
+            }
+            FixGroupView entries = view.group(268);
+            for (size_t i = 0; i < 2 && i < entries.size(); ++i) {
+                benchmark::DoNotOptimize(entries[i].getField<FixDecimal>(270));
+                benchmark::DoNotOptimize(entries[i].getField<FixDecimal>(271));
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK(BM_ParseMarketDataTopOfBook)->Arg(20)->Arg(200);
+
+// Parse plus reading the fields an order handler needs through the dictionary
+static void BM_ParseTypedExecutionReport(benchmark::State& state) {
+    auto corpus = makeCorpus(Corpus::ExecutionReport);
+    FixParser parser;
+    FixMessage msg;
+    Fix44::ExecutionReport report;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            if (!parser.parseInto(raw, msg) || !report.bind(msg)) {
+                state.SkipWithError("corpus message rejected");
+                return;
+            }
+            benchmark::DoNotOptimize(report.clOrdId());
+            benchmark::DoNotOptimize(report.ordStatus());
+            benchmark::DoNotOptimize(report.lastPx());
+            benchmark::DoNotOptimize(report.lastQty());
+            benchmark::DoNotOptimize(report.leavesQty());
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK(BM_ParseTypedExecutionReport);
+
+// Inbound NewOrderSingle parsed and read, outbound ExecutionReport encoded from it
+static void BM_ParseEncodeRoundTrip(benchmark::State& state) {
+    auto corpus = makeCorpus(Corpus::NewOrderSingle);
+    FixParser parser;
+    FixMessage msg;
+    Fix44::NewOrderSingle order;
+    FixEncoder encoder("FIX.4.4", "BROKER_COMP", "CLIENT_COMP");
+    std::vector<char> buffer(4096);
+    uint64_t seqNum = 1;
+
+    for (auto _ : state) {
+        for (const auto& raw : corpus) {
+            if (!parser.parseInto(raw, msg) || !order.bind(msg)) {
+                state.SkipWithError("corpus message rejected");
+                return;
+            }
+
+            encoder.begin(buffer, "8", seqNum++, SENDING_TIME);
+            encoder.addField(37, "EX-1");
+            encoder.addField(FixTag::ClOrdID, order.clOrdId().value_or(""));
+            encoder.addField(150, '0');
+            encoder.addField(39, '0');
+            encoder.addField(FixTag::Symbol, order.symbol().value_or(""));
+            encoder.addField(FixTag::Side, order.side().value_or('1'));
+            encoder.addField(FixTag::OrderQty, order.orderQty().value_or(FixDecimal{}));
+            encoder.addField(FixTag::Price, order.price().value_or(FixDecimal{}));
+            benchmark::DoNotOptimize(encoder.finish());
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, corpus);
+}
+BENCHMARK(BM_ParseEncodeRoundTrip);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include <span>
+#include <utility>
+#include <string>
+#include <vector>
+#include "FixParser.h"
+#include "FixMessage.h"
+#include "FixMessageView.h"
+#include "FixDecimal.h"
+#include "FixTestMessages.h"
+
+namespace {
+    // What a hot path templated on the parser looks like, no virtual call involved
+    template<FixParserLike Parser>
+    bool parseAll(Parser& parser, const std::vector<std::string>& raws, FixMessage& msg, size_t& fields) {
+        for (const auto& raw : raws) {
+            if (!parser.parseInto(raw, msg))
+                return false;
+            fields += msg.fieldCount();
+        }
+        return true;
+    }
+
+    // The tokenizer tests below use fragments without a valid header or trailer
+    const FixParserOptions NO_VALIDATION{false, false};
+}
+
+TEST(FixParserTest, ParseViewPointsIntoBuffer) {
+    FixParser parser(NO_VALIDATION);
+    FixMessageView view;
+    std::string raw = toFix("8=FIX.4.2|9=65|35=D|49=SENDER|56=TARGET|11=ORD1|55=IBM|54=1|38=100|44=123.45|10=123|");
+
+    auto result = parser.ParseFixMessageView(raw, view);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(view.size(), 11);
+
+    //1. Values are views into the caller's buffer, nothing is copied
+    auto clOrdId = view.getFieldView(11);
+    ASSERT_TRUE(clOrdId.has_value());
+    EXPECT_EQ(*clOrdId, "ORD1");
+    EXPECT_GE(clOrdId->data(), raw.data());
+    EXPECT_LT(clOrdId->data(), raw.data() + raw.size());
+
+    //2. Wire order is kept
+    EXPECT_EQ(view[0].tag, 8);
+    EXPECT_EQ(view[2].tag, 35);
+    EXPECT_EQ(view[10].tag, 10);
+
+    //3. Missing fields do not throw
+    std::string_view missing;
+    EXPECT_FALSE(view.tryGetFieldStr(9999, missing));
+    EXPECT_FALSE(view.getFieldView(9999).has_value());
+}
+
+TEST(FixParserTest, ParseViewReportsMalformedInput) {
+    FixParser parser(NO_VALIDATION);
+    FixMessageView view;
+
+    EXPECT_EQ(parser.ParseFixMessageView("", view).error(), FixError::EmptyMessage);
+    EXPECT_EQ(parser.ParseFixMessageView(toFix("8=FIX.4.2|35D|"), view).error(), FixError::MalformedField);
+    EXPECT_EQ(parser.ParseFixMessageView(toFix("8=FIX.4.2|35=D"), view).error(), FixError::MalformedField);
+    EXPECT_EQ(parser.ParseFixMessageView(toFix("8=FIX.4.2|3x=D|"), view).error(), FixError::InvalidTag);
+    EXPECT_EQ(parser.ParseFixMessageView(toFix("8=FIX.4.2|=D|"), view).error(), FixError::InvalidTag);
+}
+
+TEST(FixParserTest, ViewConvertsToOwningMessage) {
+    FixParser parser(NO_VALIDATION);
+    FixMessageView view;
+    FixMessage msg;
+    {
+        std::string raw = toFix("8=FIX.4.2|35=D|11=ORD2|58=free text with spaces|");
+        ASSERT_TRUE(parser.ParseFixMessageView(raw, view).has_value());
+        msg = view.toFixMessage();
+        // raw goes out of scope here, msg must not depend on it
+    }
+    EXPECT_EQ(msg.getFieldStr(11), "ORD2");
+    EXPECT_EQ(msg.getFieldStr(58), "free text with spaces");
+    EXPECT_EQ(msg.getField<int>(35), std::nullopt);
+}
+
+TEST(FixParserTest, ValidatesBodyLengthAndChecksum) {
+    FixParser parser;
+    FixMessageView view;
+
+    //1. Long enough for every vector kernel to be involved
+    std::string good = makeFix("35=D|49=SENDER|56=TARGET|34=12|52=20240102-09:30:00.000|11=ORD-1|55=IBM|54=1|38=100|44=10.5|");
+    EXPECT_TRUE(parser.ParseFixMessageView(good, view).has_value());
+    EXPECT_EQ(view.getFieldView(11), "ORD-1");
+
+    //2. Corrupted body byte
+    std::string corrupted = good;
+    corrupted[corrupted.find("IBM")] = 'X';
+    EXPECT_EQ(parser.ParseFixMessageView(corrupted, view).error(), FixError::ChecksumMismatch);
+
+    //3. Wrong BodyLength, digits swapped so the CheckSum still matches
+    std::string badLength = good;
+    size_t digits = badLength.find("9=") + 2;
+    ASSERT_NE(badLength[digits], badLength[digits + 1]);
+    std::swap(badLength[digits], badLength[digits + 1]);
+    EXPECT_EQ(parser.ParseFixMessageView(badLength, view).error(), FixError::InvalidBodyLength);
+
+    //4. Missing trailer or BodyLength
+    EXPECT_EQ(parser.ParseFixMessageView(toFix("8=FIX.4.4|35=0|"), view).error(), FixError::InvalidBodyLength);
+    EXPECT_EQ(parser.ParseFixMessageView(toFix("8=FIX.4.4|9=5|35=0|"), view).error(), FixError::InvalidBodyLength);
+
+    //5. Each check can be switched off on its own
+    parser.setOptions(FixParserOptions{true, false});
+    EXPECT_TRUE(parser.ParseFixMessageView(corrupted, view).has_value());
+    EXPECT_EQ(parser.ParseFixMessageView(badLength, view).error(), FixError::InvalidBodyLength);
+    parser.setOptions(FixParserOptions{false, true});
+    EXPECT_TRUE(parser.ParseFixMessageView(badLength, view).has_value());
+    EXPECT_EQ(parser.ParseFixMessageView(corrupted, view).error(), FixError::ChecksumMismatch);
+}
+
+TEST(FixParserTest, ParsesIntoReusedMessage) {
+    FixParser parser;
+    FixMessage msg;
+
+    //1. Through the interface, from a span
+    IFixParser& generic = parser;
+    std::string order = makeFix("35=D|49=SENDER|56=TARGET|34=1|11=ORD-1|55=IBM|44=10.5|");
+    ASSERT_TRUE(generic.parse(std::span<const char>(order.data(), order.size()), msg).has_value());
+    EXPECT_EQ(msg.getFieldStr(11), "ORD-1");
+    EXPECT_EQ(msg.getField<double>(44), 10.5);
+
+    //2. The same message is reused, fields of the previous parse are gone
+    std::string heartbeat = makeFix("35=0|49=SENDER|56=TARGET|34=2|");
+    ASSERT_TRUE(generic.parse(heartbeat, msg).has_value());
+    EXPECT_EQ(msg.getFieldStr(35), "0");
+    EXPECT_FALSE(msg.getFieldView(11).has_value());
+    EXPECT_EQ(msg.fieldCount(), 7);
+
+    //3. Statically dispatched
+    size_t fields = 0;
+    EXPECT_TRUE(parseAll(parser, {order, heartbeat}, msg, fields));
+    EXPECT_EQ(fields, 17);
+
+    //4. Errors come back as codes
+    EXPECT_EQ(parser.parseInto("", msg).error(), FixError::EmptyMessage);
+    EXPECT_EQ(parser.parseInto(toFix("8=FIX.4.4|9=5|3x=0|10=000|"), msg).error(), FixError::InvalidTag);
+    std::string corrupted = order;
+    corrupted[corrupted.find("IBM")] = 'X';
+    EXPECT_EQ(generic.parse(corrupted, msg).error(), FixError::ChecksumMismatch);
+}
+
+TEST(FixParserTest, IndexesRepeatingGroups) {
+    FixParser parser;
+    FixMessageView view;
+
+    //1. Incremental refresh: instances start with MDUpdateAction (279)
+    std::string raw = makeFix("35=X|49=S|56=T|34=3|262=REQ|268=3|"
+                              "279=0|269=0|55=IBM|270=10.5|271=100|"
+                              "279=1|269=1|55=IBM|270=10.75|271=200|"
+                              "279=2|269=0|55=IBM|270=10.25|271=300|5000=end|");
+    ASSERT_TRUE(parser.ParseFixMessageView(raw, view).has_value());
+
+    FixGroupView entries = view.group(268);
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_EQ(entries[1].getFieldView(270), "10.75");
+    EXPECT_EQ(entries[2].getField<FixDecimal>(271), (FixDecimal{300, 0}));
+    EXPECT_EQ(entries[0].raw(), toFix("279=0|269=0|55=IBM|270=10.5|271=100|"));
+
+    //2. Instance fields are not in the flat list, the field after the group is
+    EXPECT_FALSE(view.getFieldView(270).has_value());
+    EXPECT_EQ(view.getFieldView(268), "3");
+    EXPECT_EQ(view.getFieldView(5000), "end");
+
+    //3. Iterating an instance decodes it in wire order
+    std::vector<int> tags;
+    for (const FixField& field : entries[2])
+        tags.push_back(field.tag);
+    EXPECT_EQ(tags, (std::vector<int>{279, 269, 55, 270, 271}));
+
+    size_t instances = 0;
+    for (FixGroupInstance entry : entries) {
+        EXPECT_EQ(entry.getFieldView(55), "IBM");
+        ++instances;
+    }
+    EXPECT_EQ(instances, 3);
+
+    //4. Converting to an owning message brings the instances back, in place
+    FixMessage msg = view.toFixMessage();
+    EXPECT_EQ(msg.fieldCount(), view.size() + 15);
+    EXPECT_EQ(msg.field(7).tag, 268);
+    EXPECT_EQ(msg.field(8).tag, 279);
+    EXPECT_EQ(msg.field(23).tag, 5000);
+}
+
+TEST(FixParserTest, RepeatingGroupsFollowTheirCount) {
+    FixParser parser;
+    FixMessageView view;
+
+    //1. Snapshot: instances start with MDEntryType (269), a second group follows
+    std::string raw = makeFix("35=W|49=S|56=T|34=4|55=IBM|268=2|269=0|270=10|271=5|269=1|270=11|271=7|"
+                              "453=1|448=BROKER|447=D|452=1|");
+    ASSERT_TRUE(parser.ParseFixMessageView(raw, view).has_value());
+    EXPECT_EQ(view.group(268).size(), 2);
+    EXPECT_EQ(view.group(268)[1].getFieldView(271), "7");
+    ASSERT_EQ(view.group(453).size(), 1);
+    EXPECT_EQ(view.group(453)[0].getFieldView(448), "BROKER");
+    EXPECT_TRUE(view.group(555).empty());
+
+    //2. Empty group
+    std::string empty = makeFix("35=W|49=S|56=T|34=5|55=IBM|268=0|5000=none|");
+    ASSERT_TRUE(parser.ParseFixMessageView(empty, view).has_value());
+    EXPECT_TRUE(view.group(268).empty());
+    EXPECT_EQ(view.getFieldView(5000), "none");
+
+    //3. Count and instances disagree
+    EXPECT_EQ(parser.ParseFixMessageView(makeFix("35=X|268=3|279=0|270=1|279=0|270=2|"), view).error(), FixError::InvalidGroup);
+    EXPECT_EQ(parser.ParseFixMessageView(makeFix("35=X|268=1|279=0|270=1|279=0|270=2|"), view).error(), FixError::InvalidGroup);
+    EXPECT_EQ(parser.ParseFixMessageView(makeFix("35=X|268=1|5000=x|"), view).error(), FixError::InvalidGroup);
+    EXPECT_EQ(parser.ParseFixMessageView(makeFix("35=X|268=x|"), view).error(), FixError::InvalidGroup);
+
+    //4. A bad tag in an instance before the last one is rejected too
+    EXPECT_EQ(parser.ParseFixMessageView(makeFix("35=W|268=2|269=0|27x=10|269=1|270=11|"), view).error(), FixError::InvalidTag);
+    EXPECT_EQ(parser.ParseFixMessageView(makeFix("35=W|268=2|269=0|=10|269=1|270=11|"), view).error(), FixError::InvalidTag);
+
+    //5. FixMessage keeps every instance field flat
+    FixMessage msg;
+    ASSERT_TRUE(parser.parseInto(raw, msg).has_value());
+    EXPECT_EQ(msg.getFieldView(270), "10");
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include "FixChecksum.h"
+
+// Replace '|' with SOH so the test messages stay readable.
+inline std::string toFix(std::string msg) {
+    for (auto& c : msg) {
+        if (c == '|') c = '\x01';
+    }
+    return msg;
+}
+
+// Wraps a '|' separated body into a complete message with BodyLength and CheckSum
+inline std::string makeFix(std::string body) {
+    body = toFix(body);
+    std::string msg = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\x01", fixChecksum(msg));
+    return msg + trailer;
+}
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "FixTokenizer.h"
+
+namespace {
+    // NewOrderSingle style message with `fieldCount` body fields
+    std::string makeMessage(int fieldCount) {
+        std::string msg = "8=FIX.4.4\x01" "9=000\x01" "35=D\x01" "49=SENDER_COMP\x01" "56=TARGET_COMP\x01"
+                          "34=1024\x01" "52=20240102-09:30:00.123456\x01";
+        for (int i = 0; i < fieldCount; ++i) {
+            msg += std::to_string(5000 + i) + "=VALUE_" + std::to_string(i * 7919) + "\x01";
+        }
+        msg += "10=000\x01";
+        return msg;
+    }
+
+    // The tokenizer FixParser used before: find() per field, then find('=') inside each token
+    size_t tokenizeWithFind(std::string_view raw, std::vector<FixFieldOffset>& out) {
+        size_t count = 0;
+        size_t start = 0;
+        size_t end;
+        while ((end = raw.find('\x01', start)) != std::string_view::npos) {
+            std::string_view token = raw.substr(start, end - start);
+            size_t sep = token.find('=');
+            if (sep != std::string_view::npos) {
+                out[count++] = FixFieldOffset{static_cast<uint32_t>(start), static_cast<uint32_t>(start + sep),
+                                              static_cast<uint32_t>(end)};
+            }
+            start = end + 1;
+        }
+        return count;
+    }
+}
+
+static void BM_Tokenize_FindLoop(benchmark::State& state) {
+    std::string msg = makeMessage(state.range(0));
+    std::vector<FixFieldOffset> offsets(msg.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizeWithFind(msg, offsets));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * msg.size());
+}
+BENCHMARK(BM_Tokenize_FindLoop)->Arg(10)->Arg(30)->Arg(60);
+
+static void BM_Tokenize_Kernel(benchmark::State& state, FixTokenizerKernel kernel) {
+    std::string msg = makeMessage(state.range(0));
+    std::vector<FixFieldOffset> offsets(msg.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TokenizeFixWith(kernel, msg, offsets));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * msg.size());
+}
+BENCHMARK_CAPTURE(BM_Tokenize_Kernel, Scalar, FixTokenizerKernel::Scalar)->Arg(10)->Arg(30)->Arg(60);
+BENCHMARK_CAPTURE(BM_Tokenize_Kernel, SSE2, FixTokenizerKernel::SSE2)->Arg(10)->Arg(30)->Arg(60);
+BENCHMARK_CAPTURE(BM_Tokenize_Kernel, AVX2, FixTokenizerKernel::AVX2)->Arg(10)->Arg(30)->Arg(60);
+
+BENCHMARK_MAIN();
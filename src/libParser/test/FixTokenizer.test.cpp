@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include "FixTokenizer.h"
+#include "FixChecksum.h"
+#include "FixTestMessages.h"
+
+namespace {
+    constexpr std::array<FixTokenizerKernel, 3> ALL_KERNELS = {
+        FixTokenizerKernel::Scalar, FixTokenizerKernel::SSE2, FixTokenizerKernel::AVX2};
+}
+
+TEST(FixTokenizerTest, FindsFieldBoundaries) {
+    // Long enough to span several 32 byte blocks, with '=' inside a value
+    std::string raw = toFix("8=FIX.4.4|9=120|35=D|49=SENDER_COMP|56=TARGET_COMP|34=12|58=a=b=c|"
+                            "11=CLORD-0001|55=MSFT|54=1|38=100|44=101.25|40=2|10=042|");
+
+    for (auto kernel : ALL_KERNELS) {
+        std::vector<FixFieldOffset> offsets(64);
+        auto result = TokenizeFixWith(kernel, raw, offsets);
+        ASSERT_EQ(result.fieldCount, 14);
+        EXPECT_EQ(result.consumed, raw.size());
+
+        // 35=D
+        EXPECT_EQ(raw.substr(offsets[2].tagStart, offsets[2].equals - offsets[2].tagStart), "35");
+        EXPECT_EQ(raw.substr(offsets[2].equals + 1, offsets[2].end - offsets[2].equals - 1), "D");
+        // only the first '=' separates tag and value
+        EXPECT_EQ(raw.substr(offsets[6].equals + 1, offsets[6].end - offsets[6].equals - 1), "a=b=c");
+        EXPECT_EQ(raw.substr(offsets[13].tagStart, 2), "10");
+    }
+}
+
+TEST(FixTokenizerTest, StopsWhenOutputIsFullAndResumes) {
+    std::string raw = toFix("8=FIX.4.2|35=0|49=A|56=B|34=1|52=20240101-00:00:00|10=000|");
+
+    for (auto kernel : ALL_KERNELS) {
+        std::vector<FixFieldOffset> offsets(3);
+        auto first = TokenizeFixWith(kernel, raw, offsets);
+        EXPECT_EQ(first.fieldCount, 3);
+        EXPECT_EQ(raw.substr(first.consumed, 5), "56=B\x01");
+
+        auto second = TokenizeFixWith(kernel, std::string_view(raw).substr(first.consumed), offsets);
+        EXPECT_EQ(second.fieldCount, 3);
+        EXPECT_EQ(first.consumed + second.consumed, raw.size() - 7);
+    }
+}
+
+TEST(FixTokenizerTest, TrailingBytesAndMissingEquals) {
+    std::string raw = toFix("35=D|garbage|58=x|10=1");
+
+    for (auto kernel : ALL_KERNELS) {
+        std::vector<FixFieldOffset> offsets(8);
+        auto result = TokenizeFixWith(kernel, raw, offsets);
+        ASSERT_EQ(result.fieldCount, 3);
+        EXPECT_EQ(result.consumed, raw.size() - 4);
+        EXPECT_EQ(offsets[1].equals, offsets[1].end);
+    }
+}
+
+TEST(FixTokenizerTest, KernelsAgreeOnRandomInput) {
+    std::mt19937 rng(42);
+    const char alphabet[] = {'1', '2', '=', '\x01', 'A', '.'};
+    std::uniform_int_distribution<int> pick(0, sizeof(alphabet) - 1);
+
+    for (int round = 0; round < 200; ++round) {
+        std::string raw(rng() % 300, ' ');
+        for (auto& c : raw) c = alphabet[pick(rng)];
+
+        std::vector<FixFieldOffset> expected(raw.size() + 1);
+        auto reference = TokenizeFixWith(FixTokenizerKernel::Scalar, raw, expected);
+
+        for (auto kernel : ALL_KERNELS) {
+            std::vector<FixFieldOffset> offsets(raw.size() + 1);
+            auto result = TokenizeFixWith(kernel, raw, offsets);
+            ASSERT_EQ(result.fieldCount, reference.fieldCount);
+            ASSERT_EQ(result.consumed, reference.consumed);
+            for (size_t i = 0; i < result.fieldCount; ++i) {
+                ASSERT_EQ(offsets[i].tagStart, expected[i].tagStart);
+                ASSERT_EQ(offsets[i].equals, expected[i].equals);
+                ASSERT_EQ(offsets[i].end, expected[i].end);
+            }
+        }
+    }
+}
+
+TEST(FixTokenizerTest, ByteSumMatchesConsumedBytes) {
+    std::mt19937 rng(7);
+    const char alphabet[] = {'1', '9', '=', '\x01', 'Z', '\xff'};
+    std::uniform_int_distribution<int> pick(0, sizeof(alphabet) - 1);
+
+    for (int round = 0; round < 200; ++round) {
+        std::string raw(rng() % 300, ' ');
+        for (auto& c : raw) c = alphabet[pick(rng)];
+
+        for (auto kernel : ALL_KERNELS) {
+            // Small outputs force the early stop path too
+            for (size_t capacity : {raw.size() + 1, size_t{5}}) {
+                std::vector<FixFieldOffset> offsets(capacity);
+                auto result = TokenizeFixWith(kernel, raw, offsets, '\x01', true);
+                ASSERT_EQ(result.byteSum, fixByteSum(std::string_view(raw).substr(0, result.consumed)));
+            }
+        }
+    }
+}